@@ -0,0 +1,643 @@
+#include <benchmark/benchmark.h>
+#include "clipper.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <new>
+using namespace CLI;
+
+
+// Allocation counting
+
+static std::atomic<std::size_t> allocations { 0 };
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+
+/// Reports time per argument and allocations per iteration.
+class counters {
+public:
+    counters(benchmark::State& state, std::size_t args_per_iter)
+        : _state(state), _args(args_per_iter), _start(allocations.load()) {}
+
+    ~counters() {
+        _state.SetItemsProcessed(_state.iterations() * _args);
+        _state.counters["time/arg"] = benchmark::Counter(static_cast<double>(_args),
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+        _state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations.load() - _start),
+            benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State& _state;
+    std::size_t _args;
+    std::size_t _start;
+};
+
+
+/// Value kinds used in the scenarios.
+enum class kind { flag, integral, floating, string, path, mixed };
+
+/// A schema with a given number of options of a given kind, and a command line that uses them.
+class scenario {
+public:
+    scenario(kind k, std::size_t options, std::size_t argc, bool restricted = false) {
+        for (std::size_t i = 0; i < options; i++) {
+            _names.push_back("--option-" + std::to_string(i));
+            _alt_names.push_back("-o" + std::to_string(i));
+        }
+
+        _ints.resize(options);
+        _dbls.resize(options);
+        _flags.resize(options);
+        _strs.resize(options);
+        _paths.resize(options);
+
+        for (std::size_t i = 0; i < options; i++)
+            add(k == kind::mixed ? static_cast<kind>(i % 5) : k, i, restricted);
+
+        _args.push_back("app");
+        while (_args.size() < argc) {
+            std::size_t i = (_args.size() * 7919) % options;
+            kind ik = k == kind::mixed ? static_cast<kind>(i % 5) : k;
+
+            _args.push_back((i % 2 ? _names[i] : _alt_names[i]).c_str());
+            if (ik != kind::flag)
+                _args.push_back(value(ik, i));
+        }
+        _args.push_back(nullptr);
+    }
+
+    arg_count argc() const { return static_cast<arg_count>(_args.size() - 1); }
+    const char* const* argv() const { return _args.data(); }
+    clipper& cli() { return _cli; }
+
+private:
+    void add(kind k, std::size_t i, bool restricted) {
+        switch (k) {
+        case kind::flag:
+            _cli.add_flag(_names[i], _alt_names[i]).set(_flags[i]).doc("Flag");
+            break;
+        case kind::integral: {
+            auto& opt = _cli.add_option<int>(_names[i], _alt_names[i]).set("number", _ints[i]).doc("Integral option");
+            if (restricted)
+                opt.match(1, 2, 3, 5, 8, 13, 21, 34, 42, 55).validate("[0; 100]", pred::ibetween<0, 100>);
+            break;
+        }
+        case kind::floating: {
+            auto& opt = _cli.add_option<double>(_names[i], _alt_names[i]).set("value", _dbls[i]).doc("Floating option");
+            if (restricted)
+                opt.validate("(0; 1)", pred::between<0., 1.>);
+            break;
+        }
+        case kind::string: {
+            auto& opt = _cli.add_option<std::string>(_names[i], _alt_names[i]).set("string", _strs[i]).doc("String option");
+            if (restricted)
+                opt.match("utf8", "utf16", "cp1252", "latin1", "ascii");
+            break;
+        }
+        case kind::path:
+            _cli.add_option<std::filesystem::path>(_names[i], _alt_names[i]).set("file", _paths[i]).doc("Path option");
+            break;
+        case kind::mixed:
+            break;
+        }
+    }
+
+    static const char* value(kind k, std::size_t i) {
+        switch (k) {
+        case kind::integral: return "42";
+        case kind::floating: return "0.25";
+        case kind::string:   return i % 3 ? "latin1" : "a-longer-string-value-that-does-not-fit-sso";
+        case kind::path:     return "/usr/local/share/clipper/data/input.txt";
+        default:             return "";
+        }
+    }
+
+    std::deque<std::string> _names, _alt_names;
+    std::deque<int> _ints;
+    std::deque<double> _dbls;
+    std::deque<bool> _flags;
+    std::deque<std::string> _strs;
+    std::deque<std::filesystem::path> _paths;
+    std::vector<const char*> _args;
+    clipper _cli;
+};
+
+
+// Schema construction (startup)
+
+static void BM_Construct(benchmark::State& state) {
+    std::size_t options = static_cast<std::size_t>(state.range(0));
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < options; i++)
+        names.push_back("--option-" + std::to_string(i));
+    std::vector<int> values(options);
+
+    counters c(state, options);
+    for (auto _ : state) {
+        clipper cli;
+        for (std::size_t i = 0; i < options; i++)
+            cli.add_option<int>(names[i]).set("number", values[i]).doc("Integral option");
+        benchmark::DoNotOptimize(cli);
+    }
+}
+BENCHMARK(BM_Construct)->Arg(10)->Arg(100)->Arg(1000);
+
+
+// Parsing into the bound variables
+
+template<kind K, bool Restricted = false>
+static void BM_Parse(benchmark::State& state) {
+    scenario sc(K, static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)), Restricted);
+    sc.cli().parse(sc.argc(), sc.argv()); // warm up
+
+    counters c(state, static_cast<std::size_t>(sc.argc() - 1));
+    for (auto _ : state) {
+        bool ok = sc.cli().parse(sc.argc(), sc.argv());
+        benchmark::DoNotOptimize(ok);
+    }
+}
+
+#define CLIPPER_PARSE_ARGS ->Args({ 10, 100 })->Args({ 100, 1000 })->Args({ 1000, 10000 })->Args({ 1000, 100000 })
+
+BENCHMARK(BM_Parse<kind::flag>) CLIPPER_PARSE_ARGS;
+BENCHMARK(BM_Parse<kind::integral>) CLIPPER_PARSE_ARGS;
+BENCHMARK(BM_Parse<kind::floating>) CLIPPER_PARSE_ARGS;
+BENCHMARK(BM_Parse<kind::string>) CLIPPER_PARSE_ARGS;
+BENCHMARK(BM_Parse<kind::path>) CLIPPER_PARSE_ARGS;
+BENCHMARK(BM_Parse<kind::mixed>) CLIPPER_PARSE_ARGS;
+BENCHMARK(BM_Parse<kind::integral, true>) CLIPPER_PARSE_ARGS;
+BENCHMARK(BM_Parse<kind::floating, true>) CLIPPER_PARSE_ARGS;
+BENCHMARK(BM_Parse<kind::string, true>) CLIPPER_PARSE_ARGS;
+
+
+// Parsing (scanning + checking) into a separate result
+
+template<kind K, bool Lazy>
+static void BM_ParseResult(benchmark::State& state) {
+    scenario sc(K, static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+    const clipper& schema = sc.cli().compile();
+    parse_result res;
+    res.lazy(Lazy);
+    schema.parse(sc.argc(), sc.argv(), res); // warm up
+
+    counters c(state, static_cast<std::size_t>(sc.argc() - 1));
+    for (auto _ : state) {
+        bool ok = schema.parse(sc.argc(), sc.argv(), res);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+
+BENCHMARK(BM_ParseResult<kind::flag, false>) CLIPPER_PARSE_ARGS;
+BENCHMARK(BM_ParseResult<kind::mixed, false>) CLIPPER_PARSE_ARGS;
+BENCHMARK(BM_ParseResult<kind::mixed, true>) CLIPPER_PARSE_ARGS;
+
+
+// Failure path (every argument is an error)
+
+static void BM_ParseErrors(benchmark::State& state) {
+    scenario sc(kind::integral, 100, 1);
+    std::vector<const char*> args { "app" };
+    for (std::int64_t i = 0; i < state.range(0); i++) {
+        args.push_back(i % 2 ? "--unknown" : "-o1");
+        args.push_back("not-a-number");
+    }
+    args.push_back(nullptr);
+
+    counters c(state, args.size() - 2);
+    for (auto _ : state) {
+        bool ok = sc.cli().parse(static_cast<arg_count>(args.size() - 1), args.data());
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK(BM_ParseErrors)->Arg(100)->Arg(10000);
+
+
+// Single option assignment
+
+template<typename Tp>
+constexpr const char* sample_value() {
+    if constexpr (std::is_same_v<Tp, bool>)                       return "";
+    else if constexpr (std::is_same_v<Tp, char>)                  return "x";
+    else if constexpr (std::is_same_v<Tp, std::uint64_t>)         return "18446744073709551615";
+    else if constexpr (std::is_integral_v<Tp>)                    return "123456";
+    else if constexpr (std::is_floating_point_v<Tp>)              return "3.14159265358979";
+    else if constexpr (std::is_same_v<Tp, std::string>)           return "a-longer-string-value-that-does-not-fit-sso";
+    else if constexpr (std::is_same_v<Tp, std::string_view>)      return "a-longer-string-value-that-does-not-fit-sso";
+    else                                                          return "/usr/local/share/clipper/data/input.txt";
+}
+
+template<typename Tp>
+static void BM_Assign(benchmark::State& state) {
+    Tp value { };
+    option<Tp> opt("--option");
+    if constexpr (std::is_same_v<Tp, bool>)
+        opt.set(value);
+    else
+        opt.set("value", value);
+
+    counters c(state, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt.try_assign(sample_value<Tp>()));
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK_TEMPLATE(BM_Assign, bool);
+BENCHMARK_TEMPLATE(BM_Assign, int);
+BENCHMARK_TEMPLATE(BM_Assign, std::uint64_t);
+BENCHMARK_TEMPLATE(BM_Assign, double);
+BENCHMARK_TEMPLATE(BM_Assign, char);
+BENCHMARK_TEMPLATE(BM_Assign, std::string);
+BENCHMARK_TEMPLATE(BM_Assign, std::filesystem::path);
+BENCHMARK_TEMPLATE(BM_Assign, std::string_view);
+
+
+// Long lists given to one option
+
+static void BM_ParseList(benchmark::State& state) {
+    std::string list;
+    for (std::int64_t i = 0; i < state.range(0); i++)
+        list.append(std::to_string(i * 7919 % 1000003)).push_back(',');
+    list.pop_back();
+
+    std::vector<int> ids;
+    clipper cli;
+    cli.add_option<std::vector<int>>("--ids").set("id", ids);
+    const char* args[] { "app", "--ids", list.c_str(), nullptr };
+
+    counters c(state, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        cli.reset();
+        benchmark::DoNotOptimize(cli.parse(3, args));
+    }
+}
+BENCHMARK(BM_ParseList)->Arg(100)->Arg(50000);
+
+
+// Response files
+
+static void BM_ResponseFile(benchmark::State& state) {
+    auto path = std::filesystem::temp_directory_path() / "clipper_benchmark.rsp";
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (std::int64_t i = 0; i < state.range(0); i++)
+            out << "-f \"/data/input files/part-" << i << ".bin\"\n";
+    }
+
+    std::vector<std::string_view> files;
+    clipper cli;
+    cli.add_option<std::vector<std::string_view>>("-f").set("file", files).reserve(static_cast<std::size_t>(state.range(0)));
+    cli.allow_response_files();
+    std::string arg = "@" + path.string();
+    const char* args[] { "app", arg.c_str(), nullptr };
+
+    counters c(state, static_cast<std::size_t>(state.range(0)) * 2);
+    for (auto _ : state) {
+        cli.reset();
+        benchmark::DoNotOptimize(cli.parse(2, args));
+    }
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_ResponseFile)->Arg(1000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+
+// Attached values (--name=value)
+
+static void BM_ParseAttached(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<int> ids;
+    clipper cli;
+    cli.add_option<std::vector<int>>("--id").set("id", ids).reserve(n);
+
+    std::vector<std::string> storage;
+    for (std::size_t i = 0; i < n; i++)
+        storage.push_back("--id=" + std::to_string(i));
+    std::vector<const char*> args { "app" };
+    for (const auto& s : storage)
+        args.push_back(s.c_str());
+    args.push_back(nullptr);
+
+    counters c(state, n);
+    for (auto _ : state) {
+        cli.reset();
+        benchmark::DoNotOptimize(cli.parse(static_cast<int>(n + 1), args.data()));
+    }
+}
+BENCHMARK(BM_ParseAttached)->Arg(1000);
+
+
+// Positional arguments followed by arguments passed through after --
+
+static void BM_ParsePassthrough(benchmark::State& state) {
+    std::string tool;
+    bool verbose;
+    clipper cli;
+    cli.add_flag("--verbose").set(verbose);
+    cli.add_positional<std::string>("tool").set("tool", tool);
+
+    std::vector<const char*> args { "app", "--verbose", "gcc", "--" };
+    for (std::int64_t i = 0; i < state.range(0); i++)
+        args.push_back("-Wall");
+    args.push_back(nullptr);
+
+    counters c(state, args.size() - 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cli.parse(static_cast<int>(args.size() - 1), args.data()));
+        benchmark::DoNotOptimize(cli.passthrough().data());
+    }
+}
+BENCHMARK(BM_ParsePassthrough)->Arg(10)->Arg(10000);
+
+
+// One-character names, separate (-a -b ...) or clustered (-abc...)
+
+static void BM_ParseShort(benchmark::State& state) {
+    const bool clustered = state.range(0) != 0;
+    std::array<bool, 26> flags { };
+    std::array<std::string, 26> names;
+    clipper cli;
+    for (std::size_t i = 0; i < names.size(); i++) {
+        names[i] = { '-', static_cast<char>('a' + i) };
+        cli.add_flag(names[i]).set(flags[i]);
+    }
+
+    std::vector<std::string> storage;
+    for (int r = 0; r < 40; r++) {
+        if (clustered)
+            storage.push_back("-abcdefghijklmnopqrstuvwxyz");
+        else
+            storage.insert(storage.end(), names.begin(), names.end());
+    }
+    std::vector<const char*> args { "app" };
+    for (const auto& s : storage)
+        args.push_back(s.c_str());
+    args.push_back(nullptr);
+
+    counters c(state, 40 * names.size());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(cli.parse(static_cast<int>(args.size() - 1), args.data()));
+}
+BENCHMARK(BM_ParseShort)->Arg(0)->Arg(1);
+
+
+// Batch parsing (one command line per line)
+
+static void BM_ParseBatch(benchmark::State& state) {
+    const std::size_t lines = 100000;
+    std::string buffer;
+    for (std::size_t i = 0; i < lines; i++)
+        buffer += "--input \"/data/in " + std::to_string(i) + ".bin\" --count=" + std::to_string(i % 64) + " --verbose\n";
+
+    std::string input;
+    int count;
+    bool verbose;
+    clipper cli;
+    cli.add_option<std::string>("--input").set("file", input).req();
+    cli.add_option<int>("--count").set("n", count).validate(rules::ibetween<0, 63>);
+    cli.add_flag("--verbose").set(verbose);
+    cli.compile();
+
+    batch_result res;
+    counters c(state, lines * 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(cli.parse_batch(buffer, res, static_cast<unsigned>(state.range(0))));
+}
+BENCHMARK(BM_ParseBatch)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+
+// Allow-list lookup
+
+static void BM_AssignAllowList(benchmark::State& state) {
+    std::vector<std::string> values;
+    for (std::int64_t i = 0; i < state.range(0); i++)
+        values.push_back("tenant-" + std::to_string(i));
+
+    std::string value;
+    option<std::string> opt("--tenant");
+    opt.set("tenant", value);
+    for (const auto& v : values)
+        opt.allow(v);
+
+    counters c(state, 1);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opt.try_assign(values[i]));
+        i = (i + 7919) % values.size();
+    }
+}
+BENCHMARK(BM_AssignAllowList)->Arg(4)->Arg(16)->Arg(64)->Arg(2048);
+
+
+// Help generation
+
+static void BM_MakeHelp(benchmark::State& state) {
+    scenario sc(kind::mixed, static_cast<std::size_t>(state.range(0)), 1, true);
+    sc.cli().name("app").license("MIT").author("clipper");
+
+    counters c(state, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        sc.cli().name("app"); // discards the cached text
+        std::string help = sc.cli().make_help();
+        benchmark::DoNotOptimize(help);
+    }
+}
+BENCHMARK(BM_MakeHelp)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_WriteHelp(benchmark::State& state) {
+    scenario sc(kind::mixed, static_cast<std::size_t>(state.range(0)), 1, true);
+    sc.cli().name("app").license("MIT").author("clipper");
+    std::vector<char> buffer(sc.cli().help_text().size());
+
+    counters c(state, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sc.cli().write_help(buffer.data(), buffer.size()));
+}
+BENCHMARK(BM_WriteHelp)->Arg(10)->Arg(1000);
+
+
+// Shell completion (one TAB press: the trie is built for every request)
+
+static void BM_Complete(benchmark::State& state) {
+    std::vector<std::string> values;
+    for (std::int64_t i = 0; i < state.range(0); i++)
+        values.push_back("tenant-" + std::to_string(i));
+
+    std::string value;
+    clipper cli("app");
+    auto& opt = cli.add_option<std::string>("--tenant").set("tenant", value);
+    for (const auto& v : values)
+        opt.allow(v);
+
+    const char* words[] = { "--tenant", "tenant-12" };
+    counters c(state, 1);
+    for (auto _ : state) {
+        std::size_t found = 0;
+        cli.complete(words, [&found](std::string_view) { found++; });
+        benchmark::DoNotOptimize(found);
+    }
+}
+BENCHMARK(BM_Complete)->Arg(16)->Arg(5000);
+
+
+// Suggestions for an unknown argument (only paid for when the message is rendered)
+
+static void BM_SuggestName(benchmark::State& state) {
+    std::vector<std::string> names;
+    std::vector<int> values(static_cast<std::size_t>(state.range(0)));
+    clipper cli("app");
+    for (std::int64_t i = 0; i < state.range(0); i++)
+        names.push_back("--option-" + std::to_string(i));
+    for (std::size_t i = 0; i < names.size(); i++)
+        cli.add_option<int>(names[i]).set("n", values[i]);
+
+    const char* argv[] = { "app", "--optoin-17", "1", nullptr };
+    cli.parse(3, argv);
+    const parse_error err = cli.errors().front();
+
+    counters c(state, 1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(cli.format_error(err));
+}
+BENCHMARK(BM_SuggestName)->Arg(16)->Arg(5000);
+
+
+// Environment and configuration file layers (one resolution per parse)
+
+static void BM_ParseLayers(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<std::string> names;
+    std::vector<int> values(n);
+    std::string config;
+    for (std::size_t i = 0; i < n; i++) {
+        names.push_back("--option-" + std::to_string(i));
+        config.append("option-").append(std::to_string(i)).append(" = ").append(std::to_string(i)).push_back('\n');
+    }
+
+    auto path = std::filesystem::temp_directory_path() / "clipper_bench.ini";
+    std::ofstream(path, std::ios::binary) << config;
+
+    clipper cli("app");
+    for (std::size_t i = 0; i < n; i++)
+        cli.add_option<int>(names[i]).set("n", values[i]);
+    cli.allow_no_args();
+    cli.env_prefix("CLIPPER_BENCH_");
+    cli.config_file(path.string());
+
+    const char* argv[] = { "app", nullptr };
+    counters c(state, n);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(cli.parse(1, argv));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_ParseLayers)->Arg(10)->Arg(1000);
+
+
+// Struct binding (no option objects) against the same options added at runtime
+
+struct bench_config {
+    int a = 0, b = 0, c = 0, d = 0;
+    std::string_view e, f;
+    bool g = false, h = false;
+};
+
+static constexpr std::tuple bench_fields {
+    field { "--alpha", "-a", &bench_config::a },
+    field { "--beta", "-b", &bench_config::b },
+    field { "--gamma", "-c", &bench_config::c },
+    field { "--delta", "-d", &bench_config::d },
+    field { "--epsilon", "-e", &bench_config::e },
+    field { "--zeta", "-f", &bench_config::f },
+    field { "--eta", "-g", &bench_config::g },
+    field { "--theta", "-h", &bench_config::h }
+};
+
+static const char* bench_struct_argv[] = { "app", "--alpha", "1", "--beta", "2", "--gamma", "3", "--delta", "4",
+                                           "--epsilon", "x", "--zeta", "y", "--eta", "--theta", nullptr };
+
+static void BM_ParseStruct(benchmark::State& state) {
+    bench_config cfg;
+    counters c(state, 14);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(struct_parser<bench_fields>::parse(15, bench_struct_argv, cfg));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_ParseStruct);
+
+static void BM_ParseStructRuntime(benchmark::State& state) {
+    bench_config cfg;
+    counters c(state, 14);
+    for (auto _ : state) {
+        clipper cli("app");
+        cli.add_option<int>("--alpha", "-a").set("n", cfg.a);
+        cli.add_option<int>("--beta", "-b").set("n", cfg.b);
+        cli.add_option<int>("--gamma", "-c").set("n", cfg.c);
+        cli.add_option<int>("--delta", "-d").set("n", cfg.d);
+        cli.add_option<std::string_view>("--epsilon", "-e").set("s", cfg.e);
+        cli.add_option<std::string_view>("--zeta", "-f").set("s", cfg.f);
+        cli.add_flag("--eta", "-g").set(cfg.g);
+        cli.add_flag("--theta", "-h").set(cfg.h);
+        benchmark::DoNotOptimize(cli.parse(15, bench_struct_argv));
+    }
+}
+BENCHMARK(BM_ParseStructRuntime);
+
+
+// Typed values (durations, byte sizes, enums) against string options with a match list
+
+enum class bench_level { l0, l1, l2, l3, l4, l5, l6, l7, l8, l9, l10, l11, l12, l13, l14, l15 };
+
+template<>
+struct CLI::enum_names<bench_level> {
+    static constexpr enum_table<bench_level, 16> table {{
+        { "level-0", bench_level::l0 }, { "level-1", bench_level::l1 }, { "level-2", bench_level::l2 }, { "level-3", bench_level::l3 },
+        { "level-4", bench_level::l4 }, { "level-5", bench_level::l5 }, { "level-6", bench_level::l6 }, { "level-7", bench_level::l7 },
+        { "level-8", bench_level::l8 }, { "level-9", bench_level::l9 }, { "level-10", bench_level::l10 }, { "level-11", bench_level::l11 },
+        { "level-12", bench_level::l12 }, { "level-13", bench_level::l13 }, { "level-14", bench_level::l14 }, { "level-15", bench_level::l15 }
+    }};
+};
+
+static void BM_AssignTyped(benchmark::State& state) {
+    static const char* durations[] = { "250ms", "2s", "15min", "1h", "30000us", "5" };
+    static const char* sizes[] = { "4GiB", "512K", "10MB", "1024", "3T", "64kB" };
+    static const char* levels[] = { "level-3", "level-15", "level-0", "level-9", "level-12", "level-6" };
+
+    std::chrono::milliseconds ms;
+    byte_size size;
+    bench_level level;
+    std::string text;
+    option<std::chrono::milliseconds> ms_opt("--timeout");
+    option<byte_size> size_opt("--cache");
+    option<bench_level> level_opt("--level");
+    option<std::string> text_opt("--level");
+    ms_opt.set("time", ms);
+    size_opt.set("size", size);
+    level_opt.set("level", level);
+    text_opt.set("level", text);
+    for (std::size_t i = 0; i < enum_names<bench_level>::table.size(); i++)
+        text_opt.match(std::string(enum_names<bench_level>::table[i].name));
+
+    counters c(state, 1);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        switch (state.range(0)) {
+            case 0: benchmark::DoNotOptimize(ms_opt.try_assign(durations[i])); break;
+            case 1: benchmark::DoNotOptimize(size_opt.try_assign(sizes[i])); break;
+            case 2: benchmark::DoNotOptimize(level_opt.try_assign(levels[i])); break;
+            default: benchmark::DoNotOptimize(text_opt.try_assign(levels[i])); break;
+        }
+        i = (i + 1) % 6;
+    }
+    state.SetLabel(state.range(0) == 0 ? "duration" : state.range(0) == 1 ? "byte_size" : state.range(0) == 2 ? "enum" : "string match");
+}
+BENCHMARK(BM_AssignTyped)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
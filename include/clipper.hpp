@@ -17,18 +17,99 @@
  */
 
 #include <stdexcept>
+#include <cstdlib>
 #include <type_traits>
+#include <array>
+#include <cstdint>
+#include <bit>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <utility>
+#include <tuple>
+#include <algorithm>
 #include <unordered_map>
 #include <queue>
 #include <vector>
 #include <string>
 #include <string_view>
+#include <optional>
+#include <span>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <ratio>
+#include <compare>
+#include <limits>
 #include <charconv>
 #include <sstream>
 #include <iomanip>
 #include <filesystem>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <cerrno>
+
+
+#ifndef CLIPPER_HAS_MMAP
+    #if defined(__unix__) || defined(__APPLE__)
+        /// \brief Defines whether response files are memory-mapped (1) or read into a buffer (0).
+        #define CLIPPER_HAS_MMAP    1
+    #else
+        #define CLIPPER_HAS_MMAP    0
+    #endif
+#endif
+
+#ifndef CLIPPER_SIMD
+    /// \brief Defines whether response files are scanned with SIMD instructions (1, if available) or byte by byte (0).
+    #define CLIPPER_SIMD    1
+#endif
+
+#if CLIPPER_SIMD
+    #if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #include <immintrin.h>
+    #elif defined(__ARM_NEON)
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#if CLIPPER_HAS_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__APPLE__)
+    #include <crt_externs.h>
+#elif !defined(_WIN32)
+    extern char** environ;
+#endif
+
+
+#ifndef CLIPPER_EXCEPTIONS
+    #if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+        /// \brief Defines whether clipper may throw exceptions (1) or aborts instead (0, e.g. with -fno-exceptions).
+        #define CLIPPER_EXCEPTIONS  1
+    #else
+        #define CLIPPER_EXCEPTIONS  0
+    #endif
+#endif
+
+#if CLIPPER_EXCEPTIONS
+    /// \internal
+    /// \brief Throws an exception (aborts when exceptions are disabled).
+    #define CLIPPER_THROW(ex)   throw ex
+#else
+    #define CLIPPER_THROW(ex)   std::abort()
+#endif
+
+
+#ifndef CLIPPER_INSTRUMENT
+    /// \brief Defines whether parsing can be observed (1, see CLI::parse_observer) or the hooks are compiled out (0).
+    /// \brief Has to be the same in every translation unit.
+    #define CLIPPER_INSTRUMENT  0
+#endif
 
 
 #ifndef CLIPPER_HELP_ARG_FIELD_WIDTH
@@ -75,15 +156,113 @@ namespace CLI
     template<typename T>
     concept is_string = 
         is_basic_string_v<T> ||
+        std::is_same_v<T, std::string_view> ||
         std::is_same_v<T,std::filesystem::path>;
 
+    /**
+     *  \brief Path option type that refers to the argument instead of copying it.
+     *
+     *  Arguments are narrow strings on every platform, so a view of a path is a std::string_view.
+     *  Construct a std::filesystem::path of it only where it is needed.
+     */
+    using path_view = std::string_view;
+
+    /// \internal
+    /// \brief Checks whether a type is std::chrono::duration with an arithmetic (not a character) count.
+    template<typename>
+    struct is_duration : public std::false_type { };
+
+    /// \internal
+    /// \brief Checks whether a type is std::chrono::duration with an arithmetic (not a character) count.
+    template<typename Rep, typename Period>
+    struct is_duration<std::chrono::duration<Rep, Period>>
+    : public std::bool_constant<
+        std::is_arithmetic_v<Rep> && !is_character<Rep> && !std::is_same_v<Rep, bool>
+        > { };
+
+    /// \internal
+    /// \brief Alias to ::value property of is_duration.
+    template<typename T>
+    inline constexpr bool is_duration_v = is_duration<T>::value;
+
+    /**
+     *  \brief Option type of a size in bytes, given with an optional unit suffix.
+     *
+     *  The suffixes are the same as the ones of GNU coreutils: `K`, `M`, `G`, `T`, `P`, `E` and `KiB`, `MiB`...
+     *  are powers of 1024, `kB` (or `KB`), `MB`, `GB`... are powers of 1000, `B` or no suffix is a number of bytes.
+     */
+    struct byte_size {
+        std::uint64_t bytes = 0; ///< Number of bytes.
+
+        constexpr auto operator<=>(const byte_size&) const noexcept = default;
+    };
+
+    /**
+     *  \brief Names of the values of an enum that is used as an option type.
+     *
+     *  Specialize it with a `static constexpr` \ref enum_table named `table`,
+     *  the names are then resolved through a perfect hash generated during compilation.
+     *
+     *  \code
+     *  enum class mode { fast, safe };
+     *
+     *  template<>
+     *  struct CLI::enum_names<mode> {
+     *      static constexpr CLI::enum_table<mode, 2> table {{ { "fast", mode::fast }, { "safe", mode::safe } }};
+     *  };
+     *  \endcode
+     *
+     *  \tparam E Enum type.
+     */
+    template<typename E>
+    struct enum_names { };
+
+    /// \internal
+    /// \brief Checks whether a type is a scoped enum with a name table (\ref enum_names).
+    template<typename T>
+    concept is_named_enum =
+        std::is_enum_v<T> &&
+        !std::is_convertible_v<T, std::underlying_type_t<T>> &&
+        requires(std::string_view name, T& out) {
+            { enum_names<T>::table.find(name, out) } -> std::same_as<bool>;
+            { enum_names<T>::table.name(out) } -> std::same_as<std::string_view>;
+        };
+
+    /// \internal
+    /// \brief Checks whether a type is std::vector of single value option types (multi-value option).
+    template<typename>
+    struct is_vector : public std::false_type { };
+
+    /// \internal
+    /// \brief Checks whether a type is std::vector of single value option types (multi-value option).
+    template<typename T>
+    struct is_vector<std::vector<T>>
+    : public std::bool_constant<
+        std::negation_v<std::is_same<T, bool>> && (
+            std::is_integral_v<T>       ||
+            std::is_floating_point_v<T> ||
+            is_string<T>                ||
+            is_duration_v<T>            ||
+            std::is_same_v<T, byte_size> ||
+            is_named_enum<T>
+        )> { };
+
+    /// \internal
+    /// \brief Alias to ::value property of is_vector.
+    template<typename T>
+    inline constexpr bool is_vector_v = is_vector<T>::value;
+
     /// \brief Allowed option types.
     template<typename T>
     concept option_types = 
         std::negation_v<std::is_const<T>> && (
             std::is_integral_v<T>       ||
             std::is_floating_point_v<T> ||
-            is_string<T>
+            is_string<T>                ||
+            is_duration_v<T>            ||
+            std::is_same_v<T, byte_size> ||
+            is_named_enum<T>            ||
+            is_vector_v<T>
         );
 
     /// \brief Type of the first argument of the main function.
@@ -102,6 +281,666 @@ namespace CLI
         option
     };
 
+    /// \brief Kind of a parsing error.
+    enum class error_kind : unsigned char {
+        unknown_argument,   ///< Argument is not a name of any option.
+        missing_value,      ///< Option is the last argument and has no value.
+        invalid_value,      ///< Value could not be converted to the option type.
+        not_allowed,        ///< Value does not meet the option requirements.
+        missing_required,   ///< Required option was not given.
+        exclusive,          ///< More than one option of a mutually exclusive group was given.
+        one_of,             ///< None of the options of a require one of group was given.
+        all_of,             ///< Some, but not all of the options of a require all of group were given.
+        response_file,      ///< Response file (`@file`) could not be read.
+        environment,        ///< Value of an environment variable is not valid (\ref clipper::env_prefix()).
+        config_file         ///< Line of the configuration file is not valid (\ref clipper::config_file()), index is the line number.
+    };
+
+    /**
+     *  \brief Parsing error.
+     *
+     *  Errors are recorded in this compact form, they are turned into messages
+     *  only when requested.
+     *
+     *  \see clipper::errors() clipper::format_error() clipper::wrong()
+     */
+    struct parse_error {
+        /// \brief Value of index or slot when it does not apply.
+        static constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+
+        error_kind kind;    ///< Kind of the error.
+        std::uint32_t index { none }; ///< Index of the argument (in argv) that caused the error.
+        std::uint32_t slot { none };  ///< Slot of the option (or index of the constraint group).
+    };
+
+    /// \brief Result of assigning a value to an option.
+    enum class assign_status : unsigned char {
+        ok,             ///< The value was assigned.
+        invalid_value,  ///< The value could not be converted to the option type.
+        not_allowed     ///< The value does not meet the option requirements.
+    };
+
+    /// \brief Phase of parsing (\ref parse_observer::phase()).
+    enum class parse_phase : unsigned char {
+        expand, ///< Expanding the response files (tokenizing them).
+        scan,   ///< Resolving the arguments and converting (assigning) the values.
+        check   ///< Checking the required options and the constraint groups.
+    };
+
+    /**
+     *  \brief Receives the events of parsing (\ref clipper::observe()).
+     *
+     *  The hooks exist only if \ref CLIPPER_INSTRUMENT is 1, otherwise nothing is reported and nothing is paid.
+     *  The parsing of \ref clipper::parse(), \ref clipper::parse(arg_count, argv_ptr, parse_result&) const "parse into a result"
+     *  and of \ref clipper::parse_batch() "batches" is reported (batches without phases), batch threads call the observer at once.
+     *
+     *  \see parse_stats
+     */
+    class parse_observer {
+    public:
+        virtual ~parse_observer() = default;
+
+        /// \brief Called for every looked up argument.
+        /// \param name Argument.
+        /// \param found False if it is not a name of an option.
+        virtual void lookup(std::string_view name, bool found)
+        { (void)name; (void)found; }
+
+        /// \brief Called for every converted (or checked) value.
+        /// \param option Option name.
+        /// \param status Result of the conversion and the validation.
+        virtual void conversion(std::string_view option, assign_status status)
+        { (void)option; (void)status; }
+
+        /// \brief Called at the end of every parsing phase.
+        /// \param ph Phase.
+        /// \param time Duration of the phase.
+        virtual void phase(parse_phase ph, std::chrono::nanoseconds time)
+        { (void)ph; (void)time; }
+    };
+
+    /**
+     *  \brief Observer that counts the parsing events and dumps them as JSON.
+     *
+     *  It is also a memory resource (over an upstream one), as the memory resource of the clipper instance
+     *  it counts the allocations too. The counters are atomic, so batches parsed by many threads can be observed.
+     *
+     *  \code
+     *  CLI::parse_stats stats;
+     *  CLI::clipper cli("app", &stats);
+     *  cli.observe(&stats);
+     *  // ...
+     *  cli.parse(argc, argv);
+     *  std::fputs(stats.json().c_str(), log);
+     *  \endcode
+     */
+    class parse_stats : public parse_observer, public std::pmr::memory_resource {
+    public:
+        /// \brief Constructs a collector that allocates from an upstream resource.
+        explicit parse_stats(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+            : _upstream(upstream) {}
+
+        std::atomic<std::uint64_t> lookups { 0 }; ///< Looked up arguments.
+        std::atomic<std::uint64_t> unknown { 0 }; ///< Arguments that are not names of options.
+        std::atomic<std::uint64_t> conversions { 0 }; ///< Converted values.
+        std::atomic<std::uint64_t> invalid_values { 0 }; ///< Values that could not be converted.
+        std::atomic<std::uint64_t> not_allowed { 0 }; ///< Values that do not meet the requirements.
+        std::atomic<std::uint64_t> allocations { 0 }; ///< Allocations (if it is the memory resource).
+        std::atomic<std::uint64_t> allocated_bytes { 0 }; ///< Allocated bytes (if it is the memory resource).
+        std::array<std::atomic<std::uint64_t>, 3> phase_count { }; ///< Number of every \ref parse_phase.
+        std::array<std::atomic<std::uint64_t>, 3> phase_ns { }; ///< Total time of every \ref parse_phase (in nanoseconds).
+
+        void lookup(std::string_view, bool found) override {
+            lookups.fetch_add(1, std::memory_order_relaxed);
+            if (not found)
+                unknown.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void conversion(std::string_view, assign_status status) override {
+            conversions.fetch_add(1, std::memory_order_relaxed);
+            if (status == assign_status::invalid_value)
+                invalid_values.fetch_add(1, std::memory_order_relaxed);
+            else if (status == assign_status::not_allowed)
+                not_allowed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void phase(parse_phase ph, std::chrono::nanoseconds time) override {
+            phase_count[static_cast<std::size_t>(ph)].fetch_add(1, std::memory_order_relaxed);
+            phase_ns[static_cast<std::size_t>(ph)].fetch_add(static_cast<std::uint64_t>(time.count()), std::memory_order_relaxed);
+        }
+
+        /// \brief Sets all the counters to zero.
+        void reset() noexcept {
+            for (auto* counter : { &lookups, &unknown, &conversions, &invalid_values, &not_allowed, &allocations, &allocated_bytes })
+                counter->store(0, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < phase_count.size(); i++) {
+                phase_count[i].store(0, std::memory_order_relaxed);
+                phase_ns[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         *  \brief Creates a JSON object with the counters (one line).
+         *  \return `{"lookups":..,"unknown":..,"conversions":..,"invalid_values":..,"not_allowed":..,"allocations":..,
+         *          "allocated_bytes":..,"phases":{"expand":{"count":..,"ns":..},"scan":{..},"check":{..}}}`
+         */
+        std::string json() const {
+            std::string out("{");
+            auto field = [&out](std::string_view name, const std::atomic<std::uint64_t>& value) {
+                out.append("\"").append(name).append("\":").append(std::to_string(value.load(std::memory_order_relaxed))).push_back(',');
+            };
+
+            field("lookups", lookups);
+            field("unknown", unknown);
+            field("conversions", conversions);
+            field("invalid_values", invalid_values);
+            field("not_allowed", not_allowed);
+            field("allocations", allocations);
+            field("allocated_bytes", allocated_bytes);
+
+            out.append("\"phases\":{");
+            constexpr std::string_view names[] { "expand", "scan", "check" };
+            for (std::size_t i = 0; i < phase_count.size(); i++) {
+                out.append("\"").append(names[i]).append("\":{");
+                field("count", phase_count[i]);
+                field("ns", phase_ns[i]);
+                out.back() = '}';
+                out.push_back(',');
+            }
+            out.back() = '}';
+            out.append("}");
+            return out;
+        }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+            allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+            return _upstream->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+            _upstream->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        std::pmr::memory_resource* _upstream; ///< Resource the memory comes from.
+    };
+
+    /// \brief Shell of a completion script (\ref clipper::completion_script()).
+    enum class shell : unsigned char {
+        bash,
+        zsh,
+        fish
+    };
+
+
+    namespace detail
+    {
+        /// \internal
+        /// \brief List of types.
+        template<typename... Ts>
+        struct type_list { };
+
+        /// \internal
+        /// \brief Option value types that are dispatched on their type tag.
+        using tagged_types = type_list<
+            bool, char, signed char, unsigned char, wchar_t, char8_t, char16_t, char32_t,
+            short, unsigned short, int, unsigned int, long, unsigned long, long long, unsigned long long,
+            float, double, long double,
+            std::string, std::filesystem::path, std::string_view
+        >;
+
+        /// \internal
+        /// \brief Type tag of the types that are not in \ref tagged_types.
+        inline constexpr std::uint8_t untagged = 0xff;
+
+        /// \internal
+        /// \brief Gets the type tag of a type (position in the list).
+        template<typename T, typename... Ts>
+        consteval std::uint8_t tag_of(type_list<Ts...>) noexcept {
+            std::uint8_t tag = 0;
+            return ((std::is_same_v<T, Ts> ? true : (tag++, false)) || ...) ? tag : untagged;
+        }
+
+        /// \internal
+        /// \brief Type tag of an option value type.
+        template<typename T>
+        inline constexpr std::uint8_t type_tag = tag_of<T>(tagged_types { });
+
+        /**
+         *  \internal
+         *  \brief Calls a function template with the type that the type tag stands for.
+         *  \param tag Type tag.
+         *  \param func Generic lambda called as func.template operator()<T>().
+         *  \return False if the tag does not stand for any type (\ref untagged).
+         */
+        template<typename F, typename... Ts>
+        inline bool visit_tag(std::uint8_t tag, F&& func, type_list<Ts...>) {
+            std::uint8_t i = 0;
+            return ((tag == i++ ? (func.template operator()<Ts>(), true) : false) || ...);
+        }
+    } // namespace detail
+
+
+    /**
+     *  \brief Composable compile-time predicates for \ref option<Tp>::validate().
+     *
+     *  Rules are stateless and can be combined with `&&`, `||` and `!`.
+     *  The combination is a single type, so it is instantiated (and inlined) in one
+     *  function, and its description is composed automatically.
+     *
+     *  \code
+     *  opt.validate(CLI::rules::ibetween<1, 64> && CLI::rules::even); // documented as "[1; 64] and even"
+     *  \endcode
+     *
+     *  \see option<Tp>::validate() CLI::pred
+     */
+    namespace rules
+    {
+        /// \brief Base of all the rule types.
+        struct rule_base { };
+
+        /**
+         *  \brief Rule type.
+         *
+         *  A rule has a static `test(val)` function and a `describe(out)` member function,
+         *  that appends its description to a string.
+         */
+        template<typename R>
+        concept rule = std::is_base_of_v<rule_base, R> && std::is_default_constructible_v<R>;
+
+        /// \brief Rule that can test values of a given type.
+        template<typename R, typename T>
+        concept testable_for = rule<R> && requires(const T& val) { { R::test(val) } -> std::convertible_to<bool>; };
+
+        /// \internal
+        /// \brief Compares values of arithmetic types (integers of different signedness too).
+        template<typename L, typename R>
+        constexpr bool less(const L& lhs, const R& rhs) noexcept {
+            if constexpr (std::is_integral_v<L> && std::is_integral_v<R> && !is_character<L> && !is_character<R>)
+                return std::cmp_less(lhs, rhs);
+            else
+                return lhs < rhs;
+        }
+
+        /// \internal
+        /// \brief Appends a number to a string.
+        template<typename S, typename V>
+        void append_number(S& out, V val) {
+            char buf[64];
+            auto res = std::to_chars(buf, buf + sizeof(buf), val);
+            out.append(buf, res.ptr);
+        }
+
+        /// \internal
+        /// \brief Appends the description of an operand (in parentheses if it binds weaker than the operator).
+        template<int Precedence, typename S, rule R>
+        void describe_operand(S& out, const R& operand) {
+            if constexpr (R::precedence < Precedence) {
+                out.push_back('(');
+                operand.describe(out);
+                out.push_back(')');
+            }
+            else {
+                operand.describe(out);
+            }
+        }
+
+        /// \brief Both rules have to be met.
+        template<rule L, rule R>
+        struct and_rule : rule_base {
+            static constexpr int precedence = 1;
+            L lhs; ///< Left operand (for the description).
+            R rhs; ///< Right operand (for the description).
+
+            template<typename T>
+                requires testable_for<L, T> && testable_for<R, T>
+            static constexpr bool test(const T& val) { return L::test(val) && R::test(val); }
+
+            template<typename S>
+            void describe(S& out) const {
+                describe_operand<precedence>(out, lhs);
+                out.append(" and ");
+                describe_operand<precedence>(out, rhs);
+            }
+        };
+
+        /// \brief At least one of the rules has to be met.
+        template<rule L, rule R>
+        struct or_rule : rule_base {
+            static constexpr int precedence = 0;
+            L lhs; ///< Left operand (for the description).
+            R rhs; ///< Right operand (for the description).
+
+            template<typename T>
+                requires testable_for<L, T> && testable_for<R, T>
+            static constexpr bool test(const T& val) { return L::test(val) || R::test(val); }
+
+            template<typename S>
+            void describe(S& out) const {
+                describe_operand<precedence>(out, lhs);
+                out.append(" or ");
+                describe_operand<precedence>(out, rhs);
+            }
+        };
+
+        /// \brief The rule must not be met.
+        template<rule R>
+        struct not_rule : rule_base {
+            static constexpr int precedence = 2;
+            R operand; ///< Negated rule (for the description).
+
+            template<typename T>
+                requires testable_for<R, T>
+            static constexpr bool test(const T& val) { return !R::test(val); }
+
+            template<typename S>
+            void describe(S& out) const {
+                out.append("not ");
+                describe_operand<precedence + 1>(out, operand);
+            }
+        };
+
+        /// \brief Combines rules, both have to be met.
+        template<rule L, rule R>
+        constexpr and_rule<L, R> operator&&(L lhs, R rhs) noexcept
+        { return { { }, lhs, rhs }; }
+
+        /// \brief Combines rules, at least one has to be met.
+        template<rule L, rule R>
+        constexpr or_rule<L, R> operator||(L lhs, R rhs) noexcept
+        { return { { }, lhs, rhs }; }
+
+        /// \brief Negates a rule.
+        template<rule R>
+        constexpr not_rule<R> operator!(R operand) noexcept
+        { return { { }, operand }; }
+
+        /// \brief Comparison of a value with compile-time bounds.
+        /// \tparam Lo Lower bound (or nothing). \tparam Hi Upper bound (or nothing).
+        /// \tparam Incl Whether the bounds are included.
+        template<auto Lo, auto Hi, bool Incl>
+        struct bounds_rule : rule_base {
+            static constexpr int precedence = 3;
+            static constexpr bool has_lo = !std::is_same_v<decltype(Lo), std::nullptr_t>;
+            static constexpr bool has_hi = !std::is_same_v<decltype(Hi), std::nullptr_t>;
+
+            template<typename T>
+                requires (!has_lo || std::totally_ordered_with<T, decltype(Lo)>) && (!has_hi || std::totally_ordered_with<T, decltype(Hi)>)
+            static constexpr bool test(const T& val) {
+                if constexpr (has_lo)
+                    if (Incl ? less(val, Lo) : !less(Lo, val))
+                        return false;
+                if constexpr (has_hi)
+                    if (Incl ? less(Hi, val) : !less(val, Hi))
+                        return false;
+                return true;
+            }
+
+            template<typename S>
+            void describe(S& out) const {
+                if constexpr (has_lo && has_hi) {
+                    out.push_back(Incl ? '[' : '(');
+                    append_number(out, Lo);
+                    out.append("; ");
+                    append_number(out, Hi);
+                    out.push_back(Incl ? ']' : ')');
+                }
+                else if constexpr (has_lo) {
+                    out.append(Incl ? ">= " : "> ");
+                    append_number(out, Lo);
+                }
+                else {
+                    out.append(Incl ? "<= " : "< ");
+                    append_number(out, Hi);
+                }
+            }
+        };
+
+        /// \brief Value is divisible by a compile-time number.
+        template<auto D>
+        struct divisible_rule : rule_base {
+            static constexpr int precedence = 3;
+            static_assert(std::is_integral_v<decltype(D)> && D != 0, "Divisor must be a non-zero integer");
+
+            template<typename T>
+                requires requires(const T& val) { { val % D == 0 } -> std::convertible_to<bool>; }
+            static constexpr bool test(const T& val) { return val % D == 0; }
+
+            template<typename S>
+            void describe(S& out) const {
+                if constexpr (D == 2) {
+                    out.append("even");
+                }
+                else {
+                    out.append("divisible by ");
+                    append_number(out, D);
+                }
+            }
+        };
+
+        /// \brief Value is not divisible by two.
+        struct odd_rule : rule_base {
+            static constexpr int precedence = 3;
+
+            template<typename T>
+                requires requires(const T& val) { { val % 2 != 0 } -> std::convertible_to<bool>; }
+            static constexpr bool test(const T& val) { return val % 2 != 0; }
+
+            template<typename S>
+            void describe(S& out) const { out.append("odd"); }
+        };
+
+        /// \brief Rule made of a captureless lambda with a given description. \see make()
+        template<typename F>
+        struct custom_rule : rule_base {
+            static constexpr int precedence = 3;
+            std::string_view doc; ///< Description of the rule.
+
+            template<typename T>
+                requires std::predicate<const F&, const T&>
+            static constexpr bool test(const T& val) { return F{}(val); }
+
+            template<typename S>
+            void describe(S& out) const { out.append(doc); }
+        };
+
+        /**
+         *  \brief Makes a rule of a function object.
+         *  \param doc Description of the rule, i.e. lower case, length < 10.
+         *  \param func Captureless lambda (or another stateless function object).
+         *  \return Rule that can be combined with other rules.
+         */
+        template<typename F>
+        constexpr custom_rule<F> make(std::string_view doc, F /* func */) noexcept {
+            static_assert(std::is_empty_v<F> && std::is_default_constructible_v<F>, "Rule function must be stateless (e.g. a captureless lambda)");
+            return { { }, doc };
+        }
+
+        /// \brief Value has to be between bounds (excludes the bounds).
+        template<auto V1, auto V2>
+            requires std::is_same_v<decltype(V1), decltype(V2)> && (V1 < V2)
+        inline constexpr bounds_rule<V1, V2, false> between { };
+
+        /// \brief Value has to be between bounds (includes the bounds).
+        template<auto V1, auto V2>
+            requires std::is_same_v<decltype(V1), decltype(V2)> && (V1 < V2)
+        inline constexpr bounds_rule<V1, V2, true> ibetween { };
+
+        /// \brief Value has to be greater than a number (excludes the number).
+        template<auto V>
+        inline constexpr bounds_rule<V, nullptr, false> greater_than { };
+
+        /// \brief Value has to be greater than a number (includes the number).
+        template<auto V>
+        inline constexpr bounds_rule<V, nullptr, true> igreater_than { };
+
+        /// \brief Value has to be less than a number (excludes the number).
+        template<auto V>
+        inline constexpr bounds_rule<nullptr, V, false> less_than { };
+
+        /// \brief Value has to be less than a number (includes the number).
+        template<auto V>
+        inline constexpr bounds_rule<nullptr, V, true> iless_than { };
+
+        /// \brief Value has to be divisible by a number.
+        template<auto D>
+        inline constexpr divisible_rule<D> divisible_by { };
+
+        /// \brief Value has to be even.
+        inline constexpr divisible_rule<2> even { };
+
+        /// \brief Value has to be odd.
+        inline constexpr odd_rule odd { };
+    } // namespace rules
+
+
+    namespace detail
+    {
+        /// \internal
+        /// \brief Duration unit suffix and the length of the unit in the target period (num / den).
+        struct duration_unit {
+            std::string_view suffix; ///< Unit suffix.
+            std::intmax_t num; ///< Numerator of the unit length.
+            std::intmax_t den; ///< Denominator of the unit length.
+        };
+
+        /// \internal
+        /// \brief Creates a duration unit of a target period.
+        template<typename Unit, typename Period>
+        consteval duration_unit unit_of(std::string_view suffix) noexcept {
+            using length = std::ratio_divide<Unit, Period>;
+            return { suffix, length::num, length::den };
+        }
+
+        /// \internal
+        /// \brief Duration suffixes of a target period (the first suffix of a unit is the one that is printed).
+        template<typename Period>
+        inline constexpr std::array<duration_unit, 8> duration_units {{
+            unit_of<std::nano, Period>("ns"),
+            unit_of<std::micro, Period>("us"),
+            unit_of<std::milli, Period>("ms"),
+            unit_of<std::ratio<1>, Period>("s"),
+            unit_of<std::ratio<60>, Period>("min"),
+            unit_of<std::ratio<60>, Period>("m"),
+            unit_of<std::ratio<3600>, Period>("h"),
+            unit_of<std::ratio<86400>, Period>("d")
+        }};
+
+        /// \internal
+        /// \brief Suffix of a period (empty if it is not one of the \ref duration_units).
+        template<typename Period>
+        inline constexpr std::string_view duration_suffix = [] {
+            for (const duration_unit& u : duration_units<Period>)
+                if (u.num == 1 and u.den == 1)
+                    return u.suffix;
+            return std::string_view();
+        }();
+
+        /**
+         *  \internal
+         *  \brief Converts a number with a unit suffix (e.g. 250ms, 2h) to a duration.
+         *
+         *  A number without a suffix is a count of the duration period.
+         *  Integer counts have to be a whole number of periods and fit the count type.
+         */
+        template<typename Rep, typename Period>
+        assign_status parse_duration(std::string_view val, std::chrono::duration<Rep, Period>& out) noexcept {
+            using number = std::conditional_t<std::is_floating_point_v<Rep>, Rep, std::intmax_t>;
+            const char* const end = val.data() + val.size();
+
+            number count { };
+            auto [pos, ec] = std::from_chars(val.data(), end, count);
+            if (ec != std::errc{})
+                return assign_status::invalid_value;
+
+            const std::string_view suffix(pos, static_cast<std::size_t>(end - pos));
+            duration_unit unit { { }, 1, 1 };
+            if (not suffix.empty()) {
+                const duration_unit* u = std::find_if(duration_units<Period>.begin(), duration_units<Period>.end(),
+                    [suffix](const duration_unit& du) { return du.suffix == suffix; });
+                if (u == duration_units<Period>.end())
+                    return assign_status::invalid_value;
+                unit = *u;
+            }
+
+            if constexpr (std::is_floating_point_v<Rep>) {
+                out = std::chrono::duration<Rep, Period>(count * static_cast<Rep>(unit.num) / static_cast<Rep>(unit.den));
+            }
+            else {
+                constexpr std::intmax_t max = std::numeric_limits<std::intmax_t>::max();
+                if (unit.num != 1 and (count > max / unit.num or count < -max / unit.num))
+                    return assign_status::invalid_value;
+
+                count *= unit.num;
+                if (count % unit.den != 0 or not std::in_range<Rep>(count / unit.den))
+                    return assign_status::invalid_value;
+                out = std::chrono::duration<Rep, Period>(static_cast<Rep>(count / unit.den));
+            }
+            return assign_status::ok;
+        }
+
+        /// \internal
+        /// \brief Converts a number with a size suffix (e.g. 4GiB, 512K, 10MB) to a \ref byte_size.
+        inline assign_status parse_byte_size(std::string_view val, byte_size& out) noexcept {
+            static constexpr std::string_view prefixes = "KMGTPE"; // position + 1 is the exponent
+            const char* const end = val.data() + val.size();
+
+            std::uint64_t count = 0;
+            auto [pos, ec] = std::from_chars(val.data(), end, count);
+            if (ec != std::errc{})
+                return assign_status::invalid_value;
+
+            std::string_view suffix(pos, static_cast<std::size_t>(end - pos));
+            std::size_t exponent = 0;
+            std::uint64_t base = 1024;
+
+            if (not suffix.empty() and suffix != "B") {
+                exponent = prefixes.find(suffix.front() == 'k' ? 'K' : suffix.front()) + 1;
+                suffix.remove_prefix(1);
+
+                if (exponent == 0 or not (suffix.empty() or suffix == "iB" or suffix == "B"))
+                    return assign_status::invalid_value;
+                if (suffix == "B")
+                    base = 1000;
+            }
+
+            for (; exponent > 0; exponent--) {
+                if (count > std::numeric_limits<std::uint64_t>::max() / base)
+                    return assign_status::invalid_value;
+                count *= base;
+            }
+
+            out.bytes = count;
+            return assign_status::ok;
+        }
+
+        /// \internal
+        /// \brief Creates the text of a \ref byte_size in the largest unit that it is a whole number of.
+        inline std::string byte_size_text(byte_size val) {
+            static constexpr std::string_view iec[] = { "KiB", "MiB", "GiB", "TiB", "PiB", "EiB" };
+            static constexpr std::string_view si[] = { "kB", "MB", "GB", "TB", "PB", "EB" };
+
+            for (std::size_t e = 6; e > 0 and val.bytes != 0; e--) {
+                std::uint64_t bin = std::uint64_t(1) << (10 * e);
+                std::uint64_t dec = 1;
+                for (std::size_t i = 0; i < e; i++)
+                    dec *= 1000;
+
+                if (val.bytes % bin == 0)
+                    return std::to_string(val.bytes / bin).append(iec[e - 1]);
+                if (val.bytes % dec == 0)
+                    return std::to_string(val.bytes / dec).append(si[e - 1]);
+            }
+            return std::to_string(val.bytes);
+        }
+    } // namespace detail
+
+
     /**
      *  \internal
      *  \brief Allows casting option pointers.
@@ -110,9 +949,11 @@ namespace CLI
     class option_base {
     protected:
         std::string_view _vname; ///< Name of the type that the option holds.
-        std::string _doc; ///< Documentation of the option.
+        std::pmr::string _doc; ///< Documentation of the option.
         bool _req { false }; ///< Stores information about optioin requirement.
         bool _is_set { false }; ///< True if the option was set by the user.
+        const otype _type; ///< Option type.
+        const std::uint8_t _tag; ///< Type tag of the option value. \see detail::type_tag
         
     public:
         const std::string_view name; ///< Reference to name of the option.
@@ -121,27 +962,58 @@ namespace CLI
     public:
         /// \brief Constructs a new instance and sets its name reference.
         /// \brief Name and alternative name are the same.
-        option_base(std::string_view nm)
-            : name(nm), alt_name(nm) {}
+        option_base(std::string_view nm, otype type, std::uint8_t tag, std::pmr::memory_resource* resource)
+            : _doc(resource), _type(type), _tag(tag), name(nm), alt_name(nm) {}
 
         /// \brief Constructs a new instance and sets its name and alternative name reference.
-        option_base(std::string_view nm, std::string_view anm)
-            : name(nm), alt_name(anm) {}
+        option_base(std::string_view nm, std::string_view anm, otype type, std::uint8_t tag, std::pmr::memory_resource* resource)
+            : _doc(resource), _type(type), _tag(tag), name(nm), alt_name(anm) {}
 
         /// \brief Virtual default constructor.
         virtual ~option_base() = default;
 
-        /// \brief Creates option value info.
-        virtual void assign(std::string_view) = 0;
+        /**
+         *  \brief  Converts and assigns a value to an option without throwing.
+         *  \param  val Value to assign.
+         *  \return \ref assign_status::ok if the value was assigned, reason of the failure otherwise.
+         */
+        virtual assign_status try_assign(std::string_view val) noexcept = 0;
+
+        /**
+         *  \brief  Checks whether a value can be assigned to an option, without assigning it.
+         *  \param  val Value to check.
+         *  \return \ref assign_status::ok if the value is valid, reason of the failure otherwise.
+         */
+        virtual assign_status check(std::string_view val) const noexcept = 0;
+
+        /**
+         *  \brief Converts and assigns a value to an option.
+         *  \param val Value to assign.
+         *  \throw std::logic_error if the value is not allowed (aborts if exceptions are disabled).
+         *  \see   try_assign()
+         */
+        void assign(std::string_view val) {
+            if (try_assign(val) != assign_status::ok)
+                CLIPPER_THROW(std::logic_error("Value is not allowed"));
+        }
+
+        /// \copydoc assign()
+        void operator=(std::string_view val)
+        { assign(val); }
 
-        /// \brief Creates option value info.
-        virtual void operator=(std::string_view) = 0;
+        /**
+         *  \brief Restores the default value and marks the option as not set.
+         *
+         *  Assigning the default reuses the storage of the bound variable,
+         *  so it does not allocate once the variable had held a value of the same size.
+         */
+        virtual void reset() = 0;
 
         /**
          *  \brief  Accesses option documentation.
          *  \return Documentation reference.
          */
-        const std::string& doc() const noexcept
+        std::string_view doc() const noexcept
         { return _doc; }
 
         /**
@@ -179,14 +1051,31 @@ namespace CLI
         virtual std::string value_info() const noexcept
         { return ""; };
 
+        /**
+         * \brief Gets the values allowed by match() as they are typed (for shell completion).
+         * \param[out] out Values (nothing is added by default).
+         */
+        virtual void allowed_values(std::pmr::vector<std::pmr::string>& out) const
+        { (void)out; }
+
         /// \internal
         /// \brief Gets the type of an option.
-        virtual constexpr otype type() const noexcept = 0;
+        constexpr otype type() const noexcept
+        { return _type; }
+
+        /// \internal
+        /// \brief Gets the type tag of the option value.
+        constexpr std::uint8_t tag() const noexcept
+        { return _tag; }
     };
 
 
     /**
      *  \brief  Contains option properties.
+     *
+     *  An option of type std::string_view (or \ref path_view) is not copied,
+     *  the bound variable refers to the argument itself (argv has to outlive it).
+     *
      *  \tparam Tp Option (option value) type.
      *  \see    option<bool> option_types clipper clipper::add_option()
      */
@@ -195,16 +1084,27 @@ namespace CLI
     public:
         /// \brief Type of function that checks whether the given value meets some requirements
         using predicate = bool (*)(const Tp&);
+
+        /// \brief True for the character string types (compared as std::string_view).
+        static constexpr bool is_text = std::is_same_v<Tp, std::string> || std::is_same_v<Tp, std::string_view>;
+
+        /// \brief Type of the stored allowed values (strings use the memory resource of the option, views are copied too).
+        using match_type = std::conditional_t<is_text, std::pmr::string, Tp>;
+
+        /// \brief Number of allowed values above which they are looked up in a sorted copy (binary search).
+        static constexpr std::size_t sorted_match_threshold = 16;
         using option_base::doc;
 
         /// \brief Constructs a new instance and sets its name reference.
         /// \brief Name and alternative name are the same.
-        option(std::string_view nm)
-            : option_base(nm) {}
+        /// \param resource Memory resource for the documentation and allowed values.
+        option(std::string_view nm, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : option_base(nm, otype::option, detail::type_tag<Tp>, resource), _match_funcs(resource), _match_list(resource), _match_set(resource) {}
         
         /// \brief Constructs a new instance and sets its name and alternative name reference.
-        option(std::string_view nm, std::string_view anm)
-            : option_base(nm, anm) {}
+        /// \param resource Memory resource for the documentation and allowed values.
+        option(std::string_view nm, std::string_view anm, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : option_base(nm, anm, otype::option, detail::type_tag<Tp>, resource), _match_funcs(resource), _match_list(resource), _match_set(resource) {}
 
         /// \brief Default destructor.
         ~option() = default;
@@ -218,7 +1118,8 @@ namespace CLI
         option& set(std::string_view value_name, Tp& ref) {
             _vname = value_name;
             _ptr = &ref;
-            *_ptr = Tp();
+            _def = Tp();
+            *_ptr = _def;
             return *this;
         }
 
@@ -233,15 +1134,21 @@ namespace CLI
         template<typename V>
         option& set(std::string_view value_name, Tp& ref, V def) {
             static_assert(std::is_convertible<V, Tp>::value, "Type V must be convertible to type Tp");
+            static_assert(!(std::is_same_v<Tp, std::string_view> && is_basic_string_v<V>), "Default value of a view option must outlive it (use a string literal)");
 
             _vname = value_name;
             _ptr = &ref;
-            *_ptr = static_cast<Tp>(def);
+            _def = static_cast<Tp>(def);
+            *_ptr = _def;
             return *this;
         }
 
         /**
          *  \brief  Sets allowed values.
+         *
+         *  Short lists are searched linearly, once a list gets longer than \ref sorted_match_threshold
+         *  a sorted copy of it is kept, so checking a value takes a binary search.
+         *
          *  \param  val Values of the types convertible to the option types.
          *  \return Reference to itself.
          *  \see allow()
@@ -249,7 +1156,19 @@ namespace CLI
         template<typename... Args>
         option& match(Args&&... val) {
             static_assert((std::is_convertible_v<std::decay_t<Args>, Tp> && ...), "All arguments must be of type Tp or convertible to type Tp");
+            std::size_t first = _match_list.size();
             (_match_list.emplace_back(std::forward<Args>(val)), ... );
+
+            if (_match_list.size() > sorted_match_threshold) {
+                if (_match_set.empty()) { // crossed the threshold, sort all of them
+                    _match_set.assign(_match_list.begin(), _match_list.end());
+                    std::sort(_match_set.begin(), _match_set.end(), match_less{});
+                }
+                else { // keep the set sorted
+                    for (std::size_t i = first; i < _match_list.size(); i++)
+                        _match_set.insert(std::upper_bound(_match_set.begin(), _match_set.end(), _match_list[i], match_less{}), _match_list[i]);
+                }
+            }
             return *this;
         }
 
@@ -265,7 +1184,7 @@ namespace CLI
         }
 
         /**
-         *  \brief  Sets a function that validates the option value.
+         *  \brief  Adds a function that validates the option value (every one of them has to be met).
          *  \param  doc Description of the requirements of the given function, i.e. [0; 1], length < 10, lower case.
          *  \param  pred Function of type \ref predicate that checks whether the given value is valid (meets some requirements).
          *  \return Reference to itself.
@@ -273,20 +1192,61 @@ namespace CLI
          */
         option& validate(std::string_view doc, predicate pred) {
             _doc.append(" ").append(doc);
-            _match_func = pred;
+            _match_funcs.push_back(pred);
             return *this;
         }
 
         /**
-         *  \brief  Sets a function that validates the option value (same as \ref validate()).
-         *  \param  doc Description of the requirements of the given function, i.e. [0; 1], length < 10, lower case.
-         *  \param  pred Function of type \ref predicate that checks whether the given value is valid (meets some requirements).
+         *  \brief  Adds a \ref rules::rule "rule" that validates the option value, it is documented automatically.
+         *
+         *  The whole rule (e.g. `rules::ibetween<1, 64> && rules::even`) is checked in one inlined function.
+         *
+         *  \param  r Rule (or a combination of rules).
          *  \return Reference to itself.
-         *  \see predicate CLI::pred validate()
+         *  \see CLI::rules require()
          */
-        option& require(std::string_view doc, predicate pred) {
+        template<rules::testable_for<Tp> R>
+        option& validate(R r) {
+            _doc.push_back(' ');
+            r.describe(_doc);
+            _match_funcs.push_back([](const Tp& val) -> bool { return R::test(val); });
+            return *this;
+        }
+
+        /**
+         *  \brief  Adds a \ref rules::rule "rule" that validates the option value, with a custom description.
+         *  \param  doc Description of the requirements.
+         *  \param  r Rule (or a combination of rules).
+         *  \return Reference to itself.
+         *  \see CLI::rules require()
+         */
+        template<rules::testable_for<Tp> R>
+        option& validate(std::string_view doc, R /* r */) {
+            return validate(doc, [](const Tp& val) -> bool { return R::test(val); });
+        }
+
+        /**
+         *  \brief  Adds a function that validates the option value (same as \ref validate()).
+         *  \param  doc Description of the requirements of the given function, i.e. [0; 1], length < 10, lower case.
+         *  \param  pred Function of type \ref predicate that checks whether the given value is valid (meets some requirements).
+         *  \return Reference to itself.
+         *  \see predicate CLI::pred validate()
+         */
+        option& require(std::string_view doc, predicate pred) {
             return validate(doc, pred);
         }
+
+        /// \copydoc validate(R)
+        template<rules::testable_for<Tp> R>
+        option& require(R r) {
+            return validate(r);
+        }
+
+        /// \copydoc validate(std::string_view, R)
+        template<rules::testable_for<Tp> R>
+        option& require(std::string_view doc, R r) {
+            return validate(doc, r);
+        }
         
         /**
          *  \brief  Sets the option description.
@@ -317,80 +1277,130 @@ namespace CLI
             }
             else {
                 std::string list;
-
-                if constexpr (std::is_same_v<Tp, std::string>) {
-                    for (Tp i : _match_list)
-                        list.append(i).push_back(' ');
-                }
-                else if constexpr (std::is_same_v<Tp, std::filesystem::path>) {
-                    for (Tp i : _match_list)
-                        list.append(i.string()).push_back(' ');
-                }
-                else if constexpr (std::is_same_v<Tp, char>) {
-                    for (Tp i : _match_list)
-                        list.append(1, i).push_back(' ');
-                }
-                else if constexpr (std::is_floating_point_v<Tp>) {
-                    for (Tp i : _match_list) {
-                        // removeing zeroes at the end
-                        std::string str = std::to_string(i);
-                        std::size_t pos = str.size() - 1;  // first nonmeaning zero position
-                        while (str[pos] == '0' && pos > 0)
-                            pos--;
-                        
-                        if (str[pos] == '.')
-                            pos--;
-
-                        list.append(str.substr(0, pos + 1)).push_back(' ');
-                    }
-                }
-                else {
-                    for (Tp i : _match_list)
-                        list.append(std::to_string(i)).push_back(' ');
-                }
+                for (const match_type& i : _match_list)
+                    list.append(match_text(i)).push_back(' ');
 
                 list.pop_back();
                 return "(" + list + ")";
             }
         }
 
-        /**
-         *  \internal
-         *  \brief Converts and assigns a value to an option.
-         *  \param val Value to assign.
-         */
-        inline void assign(std::string_view val) override {
+        /// \copydoc option_base::allowed_values()
+        /// \details Every name of an enum is allowed if no values were set with match().
+        void allowed_values(std::pmr::vector<std::pmr::string>& out) const override {
+            if constexpr (is_named_enum<Tp>) {
+                if (_match_list.empty()) {
+                    for (std::size_t i = 0; i < enum_names<Tp>::table.size(); i++)
+                        out.emplace_back(enum_names<Tp>::table[i].name);
+                    return;
+                }
+            }
+
+            for (const match_type& i : _match_list) {
+                if constexpr (is_text)
+                    out.emplace_back(i);
+                else
+                    out.emplace_back(match_text(i));
+            }
+        }
+
+        using option_base::assign;
+        using option_base::operator=;
+
+        /// \copydoc option_base::try_assign()
+        inline assign_status try_assign(std::string_view val) noexcept override {
             _is_set = true;
             if constexpr (is_string<Tp>) {
-                *_ptr = val;    // have to create that value before validating it
+                convert(val, *_ptr);    // have to create that value before validating it
                 if (!validate(*_ptr))
-                    throw std::logic_error("Value is not allowed");
-            }
-            else if constexpr (is_character<Tp>) {
-                if (validate(val.front()))
-                    *_ptr = val.front();
-                else
-                    throw std::logic_error("Value is not allowed");
+                    return assign_status::not_allowed;
             }
             else {
                 Tp temp_v;
 
-                if (std::from_chars(val.begin(), val.end(), temp_v).ec == std::errc{} && validate(temp_v))
+                if (convert(val, temp_v) != assign_status::ok)
+                    return assign_status::invalid_value;
+                else if (validate(temp_v))
                     *_ptr = temp_v;
                 else
-                    throw std::logic_error("Value is not allowed");
+                    return assign_status::not_allowed;
             }
+            return assign_status::ok;
         }
 
-        /// \copydoc assign()
-        inline void operator=(std::string_view val) override {
-            assign(val);
+        /// \copydoc option_base::check()
+        inline assign_status check(std::string_view val) const noexcept override {
+            if constexpr (is_string<Tp>) {
+                if (_match_list.empty() and _match_funcs.empty())
+                    return assign_status::ok; // every string is valid, no need to create it
+            }
+
+            Tp temp_v;
+
+            if (convert(val, temp_v) != assign_status::ok)
+                return assign_status::invalid_value;
+
+            return validate(temp_v) ? assign_status::ok : assign_status::not_allowed;
+        }
+
+        /**
+         *  \internal
+         *  \brief Converts a value to the option type (without validating it).
+         *  \param val Value to convert.
+         *  \param[out] out Converted value.
+         *  \return \ref assign_status::ok or \ref assign_status::invalid_value.
+         */
+        static assign_status convert(std::string_view val, Tp& out) noexcept {
+            if constexpr (is_string<Tp>) {
+                out = val;
+            }
+            else if constexpr (is_character<Tp>) {
+                if (val.empty())
+                    return assign_status::invalid_value;
+                out = val.front();
+            }
+            else if constexpr (is_duration_v<Tp>) {
+                return detail::parse_duration(val, out);
+            }
+            else if constexpr (std::is_same_v<Tp, byte_size>) {
+                return detail::parse_byte_size(val, out);
+            }
+            else if constexpr (is_named_enum<Tp>) {
+                if (not enum_names<Tp>::table.find(val, out))
+                    return assign_status::invalid_value;
+            }
+            else {
+                if (std::from_chars(val.data(), val.data() + val.size(), out).ec != std::errc{})
+                    return assign_status::invalid_value;
+            }
+            return assign_status::ok;
+        }
+
+        /**
+         *  \internal
+         *  \brief Converts and validates a value (without assigning it).
+         *  \param val Value to convert.
+         *  \param[out] out Converted value.
+         *  \return \ref assign_status
+         */
+        assign_status read(std::string_view val, Tp& out) const noexcept {
+            if (convert(val, out) != assign_status::ok)
+                return assign_status::invalid_value;
+            return validate(out) ? assign_status::ok : assign_status::not_allowed;
+        }
+
+        /// \copydoc option_base::reset()
+        inline void reset() override {
+            _is_set = false;
+            if (nullptr != _ptr)
+                *_ptr = _def;
         }
 
         /**
          *  \internal
          *  \brief Assigns a value to an option.
          *  \param val Assigned value.
+         *  \throw std::logic_error if the value is not allowed (aborts if exceptions are disabled).
          */
         inline void operator=(Tp val) {
             _is_set = true;
@@ -398,15 +1408,10 @@ namespace CLI
                 *_ptr = val;
             }
             else {
-                throw std::logic_error("Value is not allowed");
+                CLIPPER_THROW(std::logic_error("Value is not allowed"));
             }
         }
 
-        /// \internal
-        /// \brief Gets the type of an option.
-        constexpr otype type() const noexcept override
-        { return otype::option; }
-        
     protected:
         /**
          *  \internal
@@ -416,27 +1421,98 @@ namespace CLI
          *  \see match() require()
          */
         bool validate(const Tp& val) const {
-            using ml_iter = std::vector<Tp>::const_iterator;
+            using ml_iter = std::pmr::vector<match_type>::const_iterator;
             bool is_match_list_allowed = _match_list.empty(); // if is emtpy then all values are allowed
 
-            for (ml_iter i = _match_list.begin(); i < _match_list.end(); i++) { // if _match_list empty it won't execute
-                if (*i == val) {                                                // and all values are allowed (^look up^)
-                    is_match_list_allowed = true;
-                    break;
+            if (not _match_set.empty()) {
+                is_match_list_allowed = std::binary_search(_match_set.begin(), _match_set.end(), val, match_less{});
+            }
+            else {
+                for (ml_iter i = _match_list.begin(); i < _match_list.end(); i++) { // if _match_list empty it won't execute
+                    if (equal(*i, val)) {                                           // and all values are allowed (^look up^)
+                        is_match_list_allowed = true;
+                        break;
+                    }
                 }
             }
 
-            if (nullptr == _match_func)
-                return is_match_list_allowed;
+            if (not is_match_list_allowed)
+                return false;
+
+            for (predicate pred : _match_funcs)
+                if (not pred(val))
+                    return false;
+            return true;
+        }
+
+        /// \internal
+        /// \brief Compares an allowed value with a value (strings with different allocators too).
+        static bool equal(const match_type& allowed, const Tp& val) noexcept {
+            if constexpr (is_text)
+                return std::string_view(allowed) == std::string_view(val);
             else
-                return _match_func(val) && is_match_list_allowed;
+                return allowed == val;
+        }
+
+        /// \internal
+        /// \brief Orders allowed values and values (strings with different allocators too).
+        struct match_less {
+            template<typename L, typename R>
+            bool operator()(const L& lhs, const R& rhs) const noexcept {
+                if constexpr (is_text)
+                    return std::string_view(lhs) < std::string_view(rhs);
+                else
+                    return lhs < rhs;
+            }
+        };
+
+        /// \internal
+        /// \brief Converts an allowed value to a text (as it is typed).
+        static std::string match_text(const match_type& val) {
+            if constexpr (is_text) {
+                return std::string(val);
+            }
+            else if constexpr (std::is_same_v<Tp, std::filesystem::path>) {
+                return val.string();
+            }
+            else if constexpr (std::is_same_v<Tp, char>) {
+                return std::string(1, val);
+            }
+            else if constexpr (is_duration_v<Tp>) {
+                return option<typename Tp::rep>::match_text(val.count()).append(detail::duration_suffix<typename Tp::period>);
+            }
+            else if constexpr (std::is_same_v<Tp, byte_size>) {
+                return detail::byte_size_text(val);
+            }
+            else if constexpr (is_named_enum<Tp>) {
+                return std::string(enum_names<Tp>::table.name(val));
+            }
+            else if constexpr (std::is_floating_point_v<Tp>) {
+                // removeing zeroes at the end
+                std::string str = std::to_string(val);
+                std::size_t pos = str.size() - 1;  // first nonmeaning zero position
+                while (str[pos] == '0' && pos > 0)
+                    pos--;
+
+                if (str[pos] == '.')
+                    pos--;
+
+                str.resize(pos + 1);
+                return str;
+            }
+            else {
+                return std::to_string(val);
+            }
         }
 
     private:
+        template<option_types> friend class option; // multi-value options validate their elements
+
         Tp* _ptr = nullptr;         ///< Pointer where to write parsed value to.
-        // std::string _match_func_doc; ///< Documentation of the requirements of a \ref predicate function i.e. [0; 1], length < 10, lower case
-        predicate _match_func = nullptr; ///< Function that checks wheather the value is allowed.
-        std::vector<Tp> _match_list;   ///< Contains allowed values (if empty all viable values are allowed).
+        Tp _def { };                ///< Default value (restored by \ref reset()).
+        std::pmr::vector<predicate> _match_funcs; ///< Functions that check wheather the value is allowed (all of them).
+        std::pmr::vector<match_type> _match_list; ///< Contains allowed values (if empty all viable values are allowed).
+        std::pmr::vector<match_type> _match_set; ///< Sorted allowed values (empty while the list is short).
     };
 
 
@@ -451,12 +1527,14 @@ namespace CLI
 
         /// \brief Constructs a new instance and sets its name reference.
         /// \brief Name and alternative name are the same.
-        option(std::string_view nm)
-            : option_base(nm) {}
+        /// \param resource Memory resource for the documentation.
+        option(std::string_view nm, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : option_base(nm, otype::flag, detail::type_tag<bool>, resource) {}
         
         /// \brief Constructs a new instance and sets its name and alternative name reference.
-        option(std::string_view nm, std::string_view anm)
-            : option_base(nm, anm) {}
+        /// \param resource Memory resource for the documentation.
+        option(std::string_view nm, std::string_view anm, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : option_base(nm, anm, otype::flag, detail::type_tag<bool>, resource) {}
 
         /// \brief Default destructor.
         ~option() = default; 
@@ -491,22 +1569,37 @@ namespace CLI
             return *this;
         }
 
+        using option_base::assign;
+        using option_base::operator=;
+
         /**
          *  \internal
          *  \brief Converts and assigns a value to an option (sets the option value to true).
          *  \param val Value to assign. (ignored)
+         *  \return Always \ref assign_status::ok.
          */
-        inline void assign(std::string_view /* val */) override {
+        inline assign_status try_assign(std::string_view /* val */) noexcept override {
             *_ptr = true;
             _is_set = true;
+            return assign_status::ok;
         }
-        
-        /// \copydoc assign()
-        inline void operator=(std::string_view /* val */) override {
-            *_ptr = true;
-            _is_set = true;
+
+        /**
+         *  \internal
+         *  \brief Flags take no value, so there is nothing to check.
+         *  \return Always \ref assign_status::ok.
+         */
+        inline assign_status check(std::string_view /* val */) const noexcept override {
+            return assign_status::ok;
         }
         
+        /// \copydoc option_base::reset()
+        inline void reset() override {
+            _is_set = false;
+            if (nullptr != _ptr)
+                *_ptr = false;
+        }
+
         /**
          *  \internal
          *  \brief Assigns a value to an \ref option< bool > "flag (option<bool>)".
@@ -517,442 +1610,4210 @@ namespace CLI
             _is_set = true;
         }
 
-        /// \internal
-        /// \brief Gets the type of an option.
-        constexpr otype type() const noexcept override
-        { return otype::flag; }
-
     private:
         bool* _ptr = nullptr; ///< Pointer where to write parsed value (state) to.
     };
 
 
     /**
-     *  \brief Holds all the CLI information and performs the most important actions.
-     * 
-     * This class is practically the only interface of the clipper library,
-     * that is meant to be directly used.
-     * It holds the neccessary and optional information about
-     * the application, options and flags.
-     * 
-     * Basically everything you need.
-     * 
-     *  \see \ref index "Main Page" option<bool> option<Tp> option_types
+     *  \brief Contains properties of an option that collects many values.
+     *
+     *  Every occurrence of the option appends its values to the bound vector.
+     *  A value can hold a list of elements separated by a delimiter (e.g. `--ids 1,2,3`),
+     *  numeric lists are converted in a single std::from_chars sweep over the argument.
+     *  Allowed values and predicates apply to every element.
+     *
+     *  \tparam Tp Element type.
+     *  \see   option<Tp> clipper::add_option()
      */
-    class clipper {
-        using argv_ptr = const char* const* const; ///< Type of an array with arguments pointer.
-        struct token { std::string_view option, value; }; ///< Cli option token.
+    template<typename Tp>
+        requires option_types<std::vector<Tp>>
+    class option<std::vector<Tp>> : public option_base {
     public:
-        /// \brief Default constructor.
-        clipper() = default;
+        /// \brief Type of function that checks whether the given element meets some requirements
+        using predicate = typename option<Tp>::predicate;
+        using option_base::doc;
 
-        /// \brief Constructs a clipper instance and sets the app name.
-        clipper(std::string_view app_name)
-            : _app_name(app_name) {}
+        /// \brief Constructs a new instance and sets its name reference.
+        /// \brief Name and alternative name are the same.
+        /// \param resource Memory resource for the documentation and allowed values.
+        option(std::string_view nm, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : option_base(nm, otype::option, detail::type_tag<std::vector<Tp>>, resource), _element(nm, resource) {}
 
-        /// \brief Constructs a clipper instance and sets the app name and other information.
-        clipper(std::string_view app_name, std::string_view version, std::string_view author, std::string_view license_notice)
-            : _app_name(app_name), _version(version), _author(author), _license_notice(license_notice) {}
+        /// \brief Constructs a new instance and sets its name and alternative name reference.
+        /// \param resource Memory resource for the documentation and allowed values.
+        option(std::string_view nm, std::string_view anm, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : option_base(nm, anm, otype::option, detail::type_tag<std::vector<Tp>>, resource), _element(nm, anm, resource) {}
 
         /// \brief Default destructor.
-        ~clipper() = default;
+        ~option() = default;
 
         /**
-         *  \brief  Sets the (application) name.
+         *  \brief  Sets the vector to append to and the value name (the vector is cleared).
+         *  \param  value_name Name of the element type e.g. file, id.
+         *  \param[out] ref Vector to append the option values to.
          *  \return Reference to itself.
          */
-        clipper& name(std::string_view name) noexcept {
-            _app_name = name;
+        option& set(std::string_view value_name, std::vector<Tp>& ref) {
+            _element._vname = value_name;
+            _ptr = &ref;
+            _ptr->clear();
+            _ptr->reserve(_reserve);
             return *this;
         }
 
         /**
-         *  \brief  Gets the (application) name.
-         *  \return Application name.
+         *  \brief  Sets the delimiter of the elements given in one value.
+         *  \param  delim Delimiter, '\0' turns splitting off (every value is a single element).
+         *          Default is ',' for numeric elements and none for strings.
+         *  \return Reference to itself.
          */
-        std::string_view name() const noexcept {
-            return _app_name;
+        option& delimiter(char delim) noexcept {
+            _delim = delim;
+            return *this;
         }
 
         /**
-         *  \brief  Sets the description.
+         *  \brief  Reserves room for a number of elements in the bound vector (now and after \ref reset()).
+         *  \param  count Expected number of elements.
          *  \return Reference to itself.
          */
-        clipper& description(std::string_view description) noexcept {
-            _app_description = description;
+        option& reserve(std::size_t count) {
+            _reserve = count;
+            if (nullptr != _ptr)
+                _ptr->reserve(count);
             return *this;
         }
 
-        /**
-         *  \brief 	Gets the description.
-         *  \return Description reference.
-         */
-        std::string_view description() const noexcept {
-            return _app_description;
+        /// \copydoc option<Tp>::match()
+        template<typename... Args>
+        option& match(Args&&... val) {
+            _element.match(std::forward<Args>(val)...);
+            return *this;
         }
 
-        /**
-         *  \brief  Sets the version.
-         *  \return Reference to itself.
-         */
-        clipper& version(std::string_view version) noexcept {
-            _version = version;
+        /// \copydoc option<Tp>::allow()
+        template<typename... Args>
+        option& allow(Args&&... val) {
+            return match(std::forward<Args>(val)...);
+        }
+
+        /// \copydoc option<Tp>::validate(std::string_view, predicate)
+        option& validate(std::string_view doc, predicate pred) {
+            _doc.append(" ").append(doc);
+            _element.validate(doc, pred);
             return *this;
         }
 
-        /**
-         *  \brief  Gets the version.
-         *  \return Version reference.
-         */
-        std::string_view version() const noexcept {
-            return _version;
+        /// \copydoc option<Tp>::validate(R)
+        template<rules::testable_for<Tp> R>
+        option& validate(R r) {
+            _doc.push_back(' ');
+            r.describe(_doc);
+            _element.validate(r);
+            return *this;
         }
 
-        /**
-         *  \brief  Sets the author.
-         *  \return Reference to itself.
-         */
-        clipper& author(std::string_view name) noexcept {
-            _author = name;
+        /// \copydoc option<Tp>::validate(std::string_view, R)
+        template<rules::testable_for<Tp> R>
+        option& validate(std::string_view doc, R r) {
+            _doc.append(" ").append(doc);
+            _element.validate(doc, r);
             return *this;
         }
 
-        /**
-         *  \brief  Gets the author.
-         *  \return Author reference.
-         */
-        std::string_view author() const noexcept {
-            return _author;
+        /// \copydoc option<Tp>::require(std::string_view, predicate)
+        option& require(std::string_view doc, predicate pred) {
+            return validate(doc, pred);
+        }
+
+        /// \copydoc option<Tp>::validate(R)
+        template<rules::testable_for<Tp> R>
+        option& require(R r) {
+            return validate(r);
+        }
+
+        /// \copydoc option<Tp>::validate(std::string_view, R)
+        template<rules::testable_for<Tp> R>
+        option& require(std::string_view doc, R r) {
+            return validate(doc, r);
         }
 
         /**
-         *  \brief  Sets the license notice.
+         *  \brief  Sets the option description.
+         *  \param  doc Option information (documentation).
          *  \return Reference to itself.
          */
-        clipper& license(std::string_view license_notice) noexcept {
-            _license_notice = license_notice;
+        option& doc(std::string_view doc) {
+            _doc = doc;
             return *this;
         }
 
         /**
-         *  \brief 	Gets the license notice.
-         *  \return License notice reference.
+         *  \brief  Sets the option to be required.
+         *  \return Reference to itself.
          */
-        std::string_view license() const noexcept {
-            return _license_notice;
+        option& req() {
+            _req = true;
+            return *this;
         }
 
         /**
-         *  \brief  Sets the web link.
-         *  \return Reference to itself.
+         *  \brief  Creates information about the allowed values of an option.
+         *  \return Information in format \<type\>,... or (val1 val2 ...),... (without the delimiter if there is none).
          */
-        clipper& web_link(std::string_view link) noexcept {
-            _web_link = link;
-            return *this;
+        std::string value_info() const noexcept override {
+            std::string info = _element.value_info();
+            if (_delim != '\0')
+                info.push_back(_delim);
+            return info.append("...");
+        }
+
+        /// \copydoc option_base::allowed_values()
+        void allowed_values(std::pmr::vector<std::pmr::string>& out) const override {
+            _element.allowed_values(out);
         }
 
+        using option_base::assign;
+        using option_base::operator=;
+
         /**
-         *  \brief  Gets the web link.
-         *  \return Web link reference.
+         *  \copydoc option_base::try_assign()
+         *
+         *  Appends the elements, if any of them is wrong none of them are appended.
          */
-        std::string_view web_link() const noexcept {
-            return _web_link;
+        inline assign_status try_assign(std::string_view val) noexcept override {
+            _is_set = true;
+            const std::size_t size = _ptr->size();
+
+            if (_delim != '\0') { // room for all the elements, still growing geometrically
+                std::size_t needed = size + static_cast<std::size_t>(std::count(val.begin(), val.end(), _delim)) + 1;
+                if (needed > _ptr->capacity())
+                    _ptr->reserve(std::max(needed, _ptr->capacity() * 2));
+            }
+
+            assign_status status = for_each_element(val, [this](Tp& elem) {
+                if (not _element.validate(elem))
+                    return assign_status::not_allowed;
+                _ptr->push_back(std::move(elem));
+                return assign_status::ok;
+            });
+
+            if (status != assign_status::ok)
+                _ptr->erase(_ptr->begin() + static_cast<std::ptrdiff_t>(size), _ptr->end());
+            return status;
+        }
+
+        /// \copydoc option_base::check()
+        inline assign_status check(std::string_view val) const noexcept override {
+            return for_each_element(val, [this](Tp& elem) {
+                return _element.validate(elem) ? assign_status::ok : assign_status::not_allowed;
+            });
         }
 
         /**
-         *  \brief  Adds an option of a given type.
-         *  \tparam Tp Option (option value) type.
-         *  \param  name Option name.
-         *  \return Reference to the created option.
-         *  \see    option_types option<Tp>
+         *  \internal
+         *  \brief Converts a value to a list of elements (without validating them).
+         *  \param val Value to convert.
+         *  \param[out] out Converted elements (appended).
+         *  \return \ref assign_status::ok or \ref assign_status::invalid_value.
          */
-        template<option_types Tp>
-        option<Tp>& add_option(std::string_view name) {
-            _names[name] = _options.size();
-            _options.emplace_back(std::make_unique<option<Tp>>(name));
-            return *static_cast<option<Tp>*>(_options.back().get());
+        assign_status convert(std::string_view val, std::vector<Tp>& out) const noexcept {
+            return for_each_element(val, [&out](Tp& elem) {
+                out.push_back(std::move(elem));
+                return assign_status::ok;
+            });
         }
 
         /**
-         *  \brief  Adds an option of a given type.
-         *  \tparam Tp Option (option value) type.
-         *  \param  name Primary option name.
-         *  \param  alt_name Secondary option name.
-         *  \return Reference to the created option.
-         *  \see    option_types option<Tp>
+         *  \internal
+         *  \brief Converts and validates a value (without assigning it).
+         *  \param val Value to convert.
+         *  \param[out] out Converted elements (appended).
+         *  \return \ref assign_status
          */
-        template<option_types Tp>
-        option<Tp>& add_option(std::string_view name, std::string_view alt_name) {
-            _names[name] = _options.size();
-            _names[alt_name] = _options.size();
-
-            _options.emplace_back(std::make_unique<option<Tp>>(name, alt_name));
+        assign_status read(std::string_view val, std::vector<Tp>& out) const noexcept {
+            return for_each_element(val, [this, &out](Tp& elem) {
+                if (not _element.validate(elem))
+                    return assign_status::not_allowed;
+                out.push_back(std::move(elem));
+                return assign_status::ok;
+            });
+        }
 
-            return *static_cast<option<Tp>*>(_options.back().get());
+        /// \copydoc option_base::reset()
+        inline void reset() override {
+            _is_set = false;
+            if (nullptr != _ptr)
+                _ptr->clear();
         }
 
+    private:
         /**
-         *  \brief  Adds a \ref option< bool > "flag (option<bool>)".
-         * 
-         *  This function adds new \ref option< bool > "flag (option<bool>)".
+         *  \internal
+         *  \brief Converts the elements of a value one by one (stops at the first failure).
+         *  \param val Value (list of elements).
+         *  \param func Function called with every converted element, returns \ref assign_status.
+         */
+        template<typename F>
+        assign_status for_each_element(std::string_view val, F func) const {
+            if constexpr (std::is_arithmetic_v<Tp> and not is_character<Tp>) {
+                const char* pos = val.data();
+                const char* const end = val.data() + val.size();
+
+                while (true) {
+                    Tp elem;
+                    auto [next, ec] = std::from_chars(pos, end, elem);
+                    if (ec != std::errc{} or (next != end and (_delim == '\0' or *next != _delim)))
+                        return assign_status::invalid_value;
+
+                    if (assign_status status = func(elem); status != assign_status::ok)
+                        return status;
+
+                    if (next == end)
+                        return assign_status::ok;
+                    pos = next + 1;
+                }
+            }
+            else {
+                std::size_t pos = 0;
+                while (true) {
+                    std::size_t next = _delim == '\0' ? std::string_view::npos : val.find(_delim, pos);
+
+                    Tp elem;
+                    if (option<Tp>::convert(val.substr(pos, next - pos), elem) != assign_status::ok)
+                        return assign_status::invalid_value;
+
+                    if (assign_status status = func(elem); status != assign_status::ok)
+                        return status;
+
+                    if (next == std::string_view::npos)
+                        return assign_status::ok;
+                    pos = next + 1;
+                }
+            }
+        }
+
+        std::vector<Tp>* _ptr = nullptr; ///< Vector to append the parsed values to.
+        option<Tp> _element; ///< Requirements of the elements (allowed values and predicates).
+        std::size_t _reserve = 0; ///< Number of elements to reserve room for.
+        char _delim = is_string<Tp> ? '\0' : ','; ///< Delimiter of the elements given in one value.
+    };
+
+
+    /**
+     *  \brief Compile-time declaration of an option (its names, and the help information).
+     *  \see   static_schema static_help
+     */
+    struct option_spec {
+        std::string_view name; ///< Name of the option.
+        std::string_view alt_name { }; ///< Alternative name of the option (optional).
+        std::string_view value { }; ///< Name of the option value (empty for flags), only for \ref static_help.
+        std::string_view doc { }; ///< Documentation of the option, only for \ref static_help.
+        bool required { false }; ///< True if the option is required, only for \ref static_help.
+    };
+
+    /**
+     *  \brief Compile-time information about the application.
+     *  \see   static_help
+     */
+    struct app_info {
+        std::string_view name; ///< Application name.
+        std::string_view version { }; ///< Application version.
+        std::string_view author { }; ///< Author.
+        std::string_view license { }; ///< License notice.
+        std::string_view description { }; ///< Application description.
+        std::string_view web_link { }; ///< Web link.
+        option_spec help_flag { }; ///< Help flag (no help flag if the name is empty).
+        option_spec version_flag { }; ///< Version flag (no version flag if the name is empty).
+    };
+
+
+    /// \internal
+    /// \brief Internal utilities.
+    namespace detail
+    {
+        /// \internal
+        /// \brief Slot value returned when a name is not found.
+        inline constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /// \internal
+        /// \brief Seeded FNV-1a hash (usable at compile time).
+        /// \details The final mix spreads the high bits downwards, otherwise
+        /// a power-of-two table size would only ever see the low input bits.
+        constexpr std::uint32_t hash(std::string_view str, std::uint32_t seed) noexcept {
+            std::uint32_t h = 2166136261u ^ (seed * 16777619u);
+            for (char c : str) {
+                h ^= static_cast<unsigned char>(c);
+                h *= 16777619u;
+            }
+            h ^= h >> 16;
+            h *= 0x7feb352du;
+            h ^= h >> 15;
+            return h;
+        }
+
+        /// \internal
+        /// \brief Deliberately not constexpr, reaching it during constant evaluation is a compile error.
+        inline void schema_error(const char* /* what */) noexcept { }
+
+        /// \internal
+        /// \brief Entry of a static name table.
+        struct name_entry {
+            std::string_view key; ///< Option name.
+            std::size_t slot { npos }; ///< Index of the option.
+        };
+
+        /**
+         *  \internal
+         *  \brief Allocation-free view of a perfect hash table generated by \ref static_schema.
+         *
+         *  Lookup is one hash to select a bucket displacement, one hash to select
+         *  the entry and a single string comparison.
+         */
+        struct static_name_index {
+            const name_entry* entries = nullptr; ///< Hash table (size entries).
+            const std::int32_t* displacement = nullptr; ///< Bucket displacements (size entries).
+            std::size_t size = 0; ///< Number of names (and buckets).
+
+            /// \internal
+            /// \brief Finds the slot of an option with the given name.
+            constexpr std::size_t find(std::string_view key) const noexcept {
+                if (size == 0)
+                    return npos;
+
+                std::int32_t d = displacement[hash(key, 0) % size];
+                const name_entry& e = entries[d < 0 ? static_cast<std::size_t>(-d - 1) : hash(key, static_cast<std::uint32_t>(d)) % size];
+                return e.key == key ? e.slot : npos;
+            }
+        };
+
+        /**
+         *  \internal
+         *  \brief Builds a minimal perfect hash of names (hash and displace).
+         *  \param keys Names and their slots.
+         *  \param count Number of names (at most C).
+         *  \param[out] table Hash table (count entries).
+         *  \param[out] displacement Bucket displacements (count entries).
+         */
+        template<std::size_t C>
+        constexpr void build_name_index(const std::array<name_entry, C>& keys, std::size_t count,
+                                        std::array<name_entry, C>& table, std::array<std::int32_t, C>& displacement) {
+            constexpr std::size_t capacity = C;
+            if (count == 0)
+                return;
+
+            // assign names to buckets
+            std::array<std::size_t, capacity> bucket_of { };
+            std::array<std::size_t, capacity + 1> bucket_start { };
+            for (std::size_t i = 0; i < count; i++) {
+                bucket_of[i] = hash(keys[i].key, 0) % count;
+                bucket_start[bucket_of[i] + 1]++;
+            }
+
+            std::size_t max_size = 0;
+            for (std::size_t b = 0; b < count; b++) {
+                max_size = std::max(max_size, bucket_start[b + 1]);
+                bucket_start[b + 1] += bucket_start[b];
+            }
+
+            // group keys by bucket
+            std::array<std::size_t, capacity> members { };
+            std::array<std::size_t, capacity> fill { };
+            for (std::size_t i = 0; i < count; i++)
+                members[bucket_start[bucket_of[i]] + fill[bucket_of[i]]++] = i;
+
+            // equal names always share a bucket
+            for (std::size_t b = 0; b < count; b++)
+                for (std::size_t i = bucket_start[b]; i < bucket_start[b + 1]; i++)
+                    for (std::size_t j = i + 1; j < bucket_start[b + 1]; j++)
+                        if (keys[members[i]].key == keys[members[j]].key)
+                            schema_error("duplicate name");
+
+            std::array<bool, capacity> used { };
+            std::array<std::size_t, capacity> placed { };
+            std::size_t free_pos = 0;
+
+            // the largest buckets first, so that they have the most free entries to choose from
+            for (std::size_t size = max_size; size > 0; size--) {
+                for (std::size_t b = 0; b < count; b++) {
+                    if (bucket_start[b + 1] - bucket_start[b] != size)
+                        continue;
+
+                    const std::size_t first = bucket_start[b];
+
+                    if (size == 1) {
+                        // a single key can be placed directly in a free entry
+                        while (used[free_pos])
+                            free_pos++;
+
+                        used[free_pos] = true;
+                        table[free_pos] = keys[members[first]];
+                        displacement[b] = -static_cast<std::int32_t>(free_pos) - 1;
+                        continue;
+                    }
+
+                    // search for a displacement that places all of the keys in free entries
+                    for (std::uint32_t d = 1; ; d++) {
+                        bool fits = true;
+
+                        for (std::size_t k = 0; k < size and fits; k++) {
+                            placed[k] = hash(keys[members[first + k]].key, d) % count;
+                            fits = not used[placed[k]];
+
+                            for (std::size_t p = 0; p < k and fits; p++)
+                                fits = placed[p] != placed[k];
+                        }
+
+                        if (fits) {
+                            for (std::size_t k = 0; k < size; k++) {
+                                used[placed[k]] = true;
+                                table[placed[k]] = keys[members[first + k]];
+                            }
+                            displacement[b] = static_cast<std::int32_t>(d);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         *  \internal
+         *  \brief Dense set of option slots.
+         *
+         *  Used to track required/given options and constraint groups,
+         *  checks between sets are done a whole word at a time.
+         */
+        class slot_set {
+            using word = std::uint64_t;
+            static constexpr std::size_t word_bits = 64;
+
+        public:
+            slot_set() = default;
+
+            /// \internal
+            /// \brief Constructs an empty set that allocates from a memory resource.
+            explicit slot_set(std::pmr::memory_resource* resource)
+                : _words(resource) {}
+
+            /// \internal
+            /// \brief Makes room for the given number of slots (new slots are not in the set).
+            void resize(std::size_t slots)
+            { _words.resize((slots + word_bits - 1) / word_bits); }
+
+            /// \internal
+            /// \brief Adds a slot to the set.
+            void set(std::size_t slot) noexcept
+            { _words[slot / word_bits] |= word { 1 } << (slot % word_bits); }
+
+            /// \internal
+            /// \brief Checks whether a slot is in the set.
+            bool test(std::size_t slot) const noexcept
+            { return slot / word_bits < _words.size() and (_words[slot / word_bits] & (word { 1 } << (slot % word_bits))); }
+
+            /// \internal
+            /// \brief Removes all slots from the set (keeps the capacity).
+            void clear() noexcept
+            { std::fill(_words.begin(), _words.end(), word { }); }
+
+            /// \internal
+            /// \brief Counts the slots that are in both sets.
+            std::size_t count_common(const slot_set& other) const noexcept {
+                std::size_t count = 0;
+                for (std::size_t i = 0; i < _words.size() and i < other._words.size(); i++)
+                    count += std::popcount(_words[i] & other._words[i]);
+                return count;
+            }
+
+            /// \internal
+            /// \brief Checks whether every slot of this set is in the other one.
+            bool is_subset_of(const slot_set& other) const noexcept {
+                for (std::size_t i = 0; i < _words.size(); i++)
+                    if (_words[i] & ~(i < other._words.size() ? other._words[i] : word { }))
+                        return false;
+                return true;
+            }
+
+            /**
+             *  \internal
+             *  \brief Calls a function for every slot of this set.
+             *  \param func Function called with the slot.
+             */
+            template<typename F>
+            void for_each(F func) const {
+                for (std::size_t i = 0; i < _words.size(); i++)
+                    for (word bits = _words[i]; bits; bits &= bits - 1)
+                        func(i * word_bits + std::countr_zero(bits));
+            }
+
+            /**
+             *  \internal
+             *  \brief Calls a function for every slot of this set that is not in the other one.
+             *  \param other Set of the slots to skip.
+             *  \param func Function called with the slot.
+             */
+            template<typename F>
+            void for_each_missing(const slot_set& other, F func) const {
+                for (std::size_t i = 0; i < _words.size(); i++) {
+                    word missing = _words[i] & ~(i < other._words.size() ? other._words[i] : word { });
+                    for (; missing; missing &= missing - 1)
+                        func(i * word_bits + std::countr_zero(missing));
+                }
+            }
+
+        private:
+            std::pmr::vector<word> _words; ///< Bits of the set.
+        };
+
+        /**
+         *  \internal
+         *  \brief Bump allocator that owns the objects created in it.
+         *
+         *  Objects are constructed in large contiguous chunks that are never moved,
+         *  so references to them stay valid until the arena is destroyed.
+         *  Objects are destroyed in reverse order of creation.
+         */
+        class arena {
+            /// \brief Header of an allocated chunk.
+            struct chunk { chunk* next; std::size_t size; };
+
+            /// \brief Header of a created object.
+            struct node { void (*destroy)(node*) noexcept; node* next; };
+
+            static constexpr std::size_t min_chunk = 4096; ///< Size of the first chunk.
+            static constexpr std::size_t max_chunk = 65536; ///< Size limit for chunk growth.
+            static constexpr std::size_t chunk_align = alignof(std::max_align_t); ///< Alignment of the chunks.
+
+        public:
+            /// \internal
+            /// \brief Constructs an empty arena that takes its chunks from a memory resource.
+            explicit arena(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+                : _resource(resource) {}
+
+            arena(const arena&) = delete;
+            arena& operator=(const arena&) = delete;
+
+            arena(arena&& other) noexcept
+                : _resource(other._resource), _chunks(std::exchange(other._chunks, nullptr)), _objects(std::exchange(other._objects, nullptr)),
+                  _pos(std::exchange(other._pos, nullptr)), _end(std::exchange(other._end, nullptr)),
+                  _next_size(std::exchange(other._next_size, min_chunk)) {}
+
+            arena& operator=(arena&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    _resource = other._resource;
+                    _chunks = std::exchange(other._chunks, nullptr);
+                    _objects = std::exchange(other._objects, nullptr);
+                    _pos = std::exchange(other._pos, nullptr);
+                    _end = std::exchange(other._end, nullptr);
+                    _next_size = std::exchange(other._next_size, min_chunk);
+                }
+                return *this;
+            }
+
+            ~arena()
+            { release(); }
+
+            /**
+             *  \internal
+             *  \brief Constructs an object in the arena.
+             *  \return Reference to the object (valid for the lifetime of the arena).
+             */
+            template<typename T, typename... Args>
+            T& create(Args&&... args) {
+                constexpr std::size_t offset = (sizeof(node) + alignof(T) - 1) / alignof(T) * alignof(T);
+                std::byte* mem = allocate(offset + sizeof(T), std::max(alignof(T), alignof(node)));
+
+                T* obj = ::new (mem + offset) T(std::forward<Args>(args)...);
+                _objects = ::new (mem) node {
+                    [](node* n) noexcept { std::destroy_at(std::launder(reinterpret_cast<T*>(reinterpret_cast<std::byte*>(n) + offset))); },
+                    _objects
+                };
+                return *obj;
+            }
+
+        private:
+            /// \internal
+            /// \brief Allocates raw memory from the current chunk (or a new one).
+            std::byte* allocate(std::size_t size, std::size_t align) {
+                std::byte* p = align_up(_pos, align);
+
+                if (_pos == nullptr or p + size > _end) {
+                    std::size_t chunk_size = std::max(_next_size, size + align + sizeof(chunk));
+                    _next_size = std::min(_next_size * 2, max_chunk);
+
+                    auto* c = static_cast<chunk*>(_resource->allocate(chunk_size, chunk_align));
+                    *c = { _chunks, chunk_size };
+                    _chunks = c;
+                    _pos = reinterpret_cast<std::byte*>(c + 1);
+                    _end = reinterpret_cast<std::byte*>(c) + chunk_size;
+                    p = align_up(_pos, align);
+                }
+
+                _pos = p + size;
+                return p;
+            }
+
+            /// \internal
+            /// \brief Aligns a pointer.
+            static std::byte* align_up(std::byte* p, std::size_t align) noexcept {
+                auto addr = reinterpret_cast<std::uintptr_t>(p);
+                return reinterpret_cast<std::byte*>((addr + align - 1) & ~(align - 1));
+            }
+
+            /// \internal
+            /// \brief Destroys all objects and frees the chunks.
+            void release() noexcept {
+                for (node* n = _objects; n != nullptr; ) {
+                    node* next = n->next;
+                    n->destroy(n);
+                    n = next;
+                }
+
+                while (_chunks != nullptr) {
+                    chunk* c = std::exchange(_chunks, _chunks->next);
+                    _resource->deallocate(c, c->size, chunk_align);
+                }
+
+                _objects = nullptr;
+                _pos = _end = nullptr;
+            }
+
+            std::pmr::memory_resource* _resource; ///< Source of the chunks.
+            chunk* _chunks = nullptr; ///< Allocated chunks (the most recent first).
+            node* _objects = nullptr; ///< Created objects (the most recent first).
+            std::byte* _pos = nullptr; ///< Free memory of the current chunk.
+            std::byte* _end = nullptr; ///< End of the current chunk.
+            std::size_t _next_size = min_chunk; ///< Size of the next chunk.
+        };
+
+        /**
+         *  \internal
+         *  \brief View of the arguments that are parsed.
+         *
+         *  Either the argv array, or the arguments expanded from response files.
+         */
+        struct arg_list {
+            const char* const* argv = nullptr; ///< Arguments given to parse (if not expanded).
+            const std::string_view* views = nullptr; ///< Expanded arguments (if any).
+            std::size_t size = 0; ///< Number of arguments.
+
+            /// \internal
+            /// \brief Gets an argument.
+            std::string_view operator[](std::size_t i) const noexcept
+            { return nullptr != views ? views[i] : std::string_view(argv[i]); }
+        };
+
+        /// \internal
+        /// \brief Gets the environment variables (`NAME=value`, null-terminated array).
+        inline char** environment() noexcept {
+#if defined(_WIN32)
+            return _environ;
+#elif defined(__APPLE__)
+            return *_NSGetEnviron();
+#else
+            return ::environ;
+#endif
+        }
+
+        /**
+         *  \internal
+         *  \brief Contents of a file that can be modified in place.
+         *
+         *  The file is mapped privately (copy-on-write), so only the pages that are changed
+         *  are copied and the file itself is never modified.
+         *  Without mmap support the file is read into a buffer.
+         */
+        class mapped_file {
+        public:
+            mapped_file() = default;
+            mapped_file(const mapped_file&) = delete;
+            mapped_file& operator=(const mapped_file&) = delete;
+
+            mapped_file(mapped_file&& other) noexcept
+                : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0)) {}
+
+            mapped_file& operator=(mapped_file&& other) noexcept {
+                if (this != &other) {
+                    close();
+                    _data = std::exchange(other._data, nullptr);
+                    _size = std::exchange(other._size, 0);
+                }
+                return *this;
+            }
+
+            ~mapped_file()
+            { close(); }
+
+            /**
+             *  \internal
+             *  \brief Maps (or reads) a file.
+             *  \param path Null-terminated path of the file.
+             *  \return True if the file was opened, false otherwise.
+             */
+            bool open(const char* path) noexcept {
+                close();
+#if CLIPPER_HAS_MMAP
+                int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+                if (fd < 0)
+                    return false;
+
+                struct stat st;
+                bool ok = ::fstat(fd, &st) == 0 and S_ISREG(st.st_mode);
+                if (ok and st.st_size > 0) {
+                    void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                    if (p != MAP_FAILED) {
+                        ::madvise(p, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+                        _data = static_cast<char*>(p);
+                        _size = static_cast<std::size_t>(st.st_size);
+                    }
+                    else {
+                        ok = false;
+                    }
+                }
+
+                ::close(fd);
+                return ok;
+#else
+                std::FILE* file = std::fopen(path, "rb");
+                if (nullptr == file)
+                    return false;
+
+                bool ok = std::fseek(file, 0, SEEK_END) == 0;
+                long size = ok ? std::ftell(file) : -1;
+                ok = size >= 0 and std::fseek(file, 0, SEEK_SET) == 0;
+
+                if (ok and size > 0) {
+                    _data = new (std::nothrow) char[static_cast<std::size_t>(size)];
+                    _size = static_cast<std::size_t>(size);
+                    ok = nullptr != _data and std::fread(_data, 1, _size, file) == _size;
+                }
+
+                std::fclose(file);
+                if (not ok)
+                    close();
+                return ok;
+#endif
+            }
+
+            /// \internal
+            /// \brief Gets the contents.
+            char* data() const noexcept
+            { return _data; }
+
+            /// \internal
+            /// \brief Gets the size of the contents.
+            std::size_t size() const noexcept
+            { return _size; }
+
+        private:
+            /// \internal
+            /// \brief Unmaps (or frees) the contents.
+            void close() noexcept {
+                if (nullptr != _data) {
+#if CLIPPER_HAS_MMAP
+                    ::munmap(_data, _size);
+#else
+                    delete[] _data;
+#endif
+                }
+                _data = nullptr;
+                _size = 0;
+            }
+
+            char* _data = nullptr; ///< Contents of the file.
+            std::size_t _size = 0; ///< Size of the contents.
+        };
+
+        /// \internal
+        /// \brief Checks whether a character separates, quotes or escapes response file arguments.
+        constexpr bool is_response_special(char c) noexcept {
+            auto u = static_cast<unsigned char>(c);
+            return u == ' ' or static_cast<unsigned char>(u - '\t') < 5 or u == '"' or u == '\'' or u == '\\';
+        }
+
+        /// \internal
+        /// \brief Finds the first \ref is_response_special "special" character (byte by byte).
+        inline const char* find_response_special_scalar(const char* pos, const char* end) noexcept {
+            while (pos != end and not is_response_special(*pos))
+                pos++;
+            return pos;
+        }
+
+        /**
+         *  \internal
+         *  \brief Finds the first \ref is_response_special "special" character.
+         *
+         *  Checks 32 (AVX2) or 16 (SSE2, NEON) bytes at a time, the rest byte by byte.
+         *
+         *  \return Pointer to the character, or end if there is none.
+         */
+        inline const char* find_response_special(const char* pos, const char* end) noexcept {
+#if CLIPPER_SIMD && defined(__AVX2__)
+            {
+                const __m256i tab = _mm256_set1_epi8('\t'), four = _mm256_set1_epi8(4), space = _mm256_set1_epi8(' ');
+                const __m256i dquote = _mm256_set1_epi8('"'), squote = _mm256_set1_epi8('\''), bslash = _mm256_set1_epi8('\\');
+
+                for (; end - pos >= 32; pos += 32) {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+                    __m256i ws = _mm256_sub_epi8(x, tab); // \t \n \v \f \r are 0-4
+                    __m256i m = _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(ws, four), ws), _mm256_cmpeq_epi8(x, space)),
+                        _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, dquote), _mm256_cmpeq_epi8(x, squote)), _mm256_cmpeq_epi8(x, bslash)));
+
+                    if (auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m)))
+                        return pos + std::countr_zero(mask);
+                }
+            }
+#endif
+#if CLIPPER_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+            {
+                const __m128i tab = _mm_set1_epi8('\t'), four = _mm_set1_epi8(4), space = _mm_set1_epi8(' ');
+                const __m128i dquote = _mm_set1_epi8('"'), squote = _mm_set1_epi8('\''), bslash = _mm_set1_epi8('\\');
+
+                for (; end - pos >= 16; pos += 16) {
+                    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+                    __m128i ws = _mm_sub_epi8(x, tab);
+                    __m128i m = _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(ws, four), ws), _mm_cmpeq_epi8(x, space)),
+                        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, dquote), _mm_cmpeq_epi8(x, squote)), _mm_cmpeq_epi8(x, bslash)));
+
+                    if (auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(m)))
+                        return pos + std::countr_zero(mask);
+                }
+            }
+#elif CLIPPER_SIMD && defined(__ARM_NEON)
+            {
+                const uint8x16_t tab = vdupq_n_u8('\t'), four = vdupq_n_u8(4), space = vdupq_n_u8(' ');
+                const uint8x16_t dquote = vdupq_n_u8('"'), squote = vdupq_n_u8('\''), bslash = vdupq_n_u8('\\');
+
+                for (; end - pos >= 16; pos += 16) {
+                    uint8x16_t x = vld1q_u8(reinterpret_cast<const std::uint8_t*>(pos));
+                    uint8x16_t m = vorrq_u8(
+                        vorrq_u8(vcleq_u8(vsubq_u8(x, tab), four), vceqq_u8(x, space)),
+                        vorrq_u8(vorrq_u8(vceqq_u8(x, dquote), vceqq_u8(x, squote)), vceqq_u8(x, bslash)));
+
+                    // narrows the mask to 4 bits per byte
+                    std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+                    if (mask)
+                        return pos + (std::countr_zero(mask) >> 2);
+                }
+            }
+#endif
+            return find_response_special_scalar(pos, end);
+        }
+
+        /**
+         *  \internal
+         *  \brief Splits response file contents into arguments, in place.
+         *
+         *  Arguments are separated with whitespace, single and double quotes group characters
+         *  (whitespace included), a backslash escapes the next character (only `"` and `\` in double quotes).
+         *  Quotes and escapes are removed by moving the characters back, memory is only written
+         *  after the first removed character, so the untouched pages of a mapped file are not copied.
+         *  Runs of ordinary characters are found with \ref find_response_special() and moved at once.
+         *
+         *  \param pos Beginning of the contents.
+         *  \param end End of the contents.
+         *  \param emit Function called with every argument.
+         */
+        template<typename F>
+        void tokenize(char* pos, char* const end, F emit) {
+            auto is_space = [](char c) { return c == ' ' or c == '\t' or c == '\n' or c == '\r' or c == '\f' or c == '\v'; };
+
+            while (true) {
+                while (pos != end and is_space(*pos))
+                    pos++;
+                if (pos == end)
+                    return;
+
+                char* const begin = pos;
+                char* out = pos;
+                char quote = '\0';
+
+                auto put = [&out, &pos](char c) {
+                    if (out != pos)
+                        *out = c;
+                    out++;
+                };
+
+                while (pos != end) {
+                    auto run = static_cast<std::size_t>(find_response_special(pos, end) - pos);
+                    if (run != 0) {
+                        if (out != pos)
+                            std::memmove(out, pos, run);
+                        out += run;
+                        pos += run;
+                        if (pos == end)
+                            break;
+                    }
+
+                    char c = *pos;
+
+                    if (quote != '\0') {
+                        if (c == quote) {
+                            quote = '\0';
+                            pos++;
+                        }
+                        else if (c == '\\' and quote == '"' and pos + 1 != end and (pos[1] == '"' or pos[1] == '\\')) {
+                            pos++;
+                            put(*pos++);
+                        }
+                        else {
+                            put(c);
+                            pos++;
+                        }
+                    }
+                    else if (is_space(c)) {
+                        break;
+                    }
+                    else if (c == '"' or c == '\'') {
+                        quote = c;
+                        pos++;
+                    }
+                    else if (c == '\\' and pos + 1 != end) {
+                        pos++;
+                        put(*pos++);
+                    }
+                    else {
+                        put(c);
+                        pos++;
+                    }
+                }
+
+                emit(std::string_view(begin, static_cast<std::size_t>(out - begin)));
+            }
+        }
+
+        /**
+         *  \internal
+         *  \brief Expands `@file` arguments into the arguments listed in the files.
+         *
+         *  The files stay mapped and the expanded arguments refer to them,
+         *  until the next expansion (or destruction).
+         */
+        class response_files {
+        public:
+            /// \internal
+            /// \brief Maximum nesting of response files (guards against cycles).
+            static constexpr std::size_t max_depth = 16;
+
+            /// \internal
+            /// \brief Constructs an empty instance that allocates from a memory resource.
+            explicit response_files(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                : _files(resource), _args(resource), _unreadable(resource) {}
+
+            /**
+             *  \internal
+             *  \brief Expands the response files given in the arguments.
+             *  \param argc Argument count.
+             *  \param argv Arguments.
+             *  \param[out] errors Files that could not be read (\ref error_kind::response_file).
+             *  \return Expanded arguments, or argv itself if there are no response files.
+             *
+             *  The arguments after `--` are not expanded, they are copied as they are (\ref tail()).
+             *  Files that could not be read are left out, they are kept after the returned arguments
+             *  (where the indices of their errors point to).
+             */
+            arg_list expand(std::size_t argc, const char* const* argv, std::pmr::vector<parse_error>& errors) {
+                clear();
+
+                std::size_t first = 1;
+                while (first < argc and argv[first][0] != '@' and std::string_view(argv[first]) != "--")
+                    first++;
+
+                if (first >= argc or argv[first][0] != '@')
+                    return { argv, nullptr, argc };
+
+                const std::size_t recorded = errors.size();
+                _args.reserve(argc);
+                _args.assign(argv, argv + first);
+                for (std::size_t i = first; i < argc; i++) {
+                    if (std::string_view(argv[i]) == "--") {
+                        _tail = argc - i - 1;
+                        _args.insert(_args.end(), argv + i, argv + argc);
+                        break;
+                    }
+                    add(argv[i], errors, 0);
+                }
+
+                const std::size_t size = _args.size();
+                for (std::size_t e = recorded; e < errors.size(); e++)
+                    errors[e].index += static_cast<std::uint32_t>(size);
+                _args.insert(_args.end(), _unreadable.begin(), _unreadable.end());
+                return { nullptr, _args.data(), size };
+            }
+
+            /// \internal
+            /// \brief Gets the number of arguments after the `--` given in argv (not in a file), \ref npos if there is none.
+            std::size_t tail() const noexcept
+            { return _tail; }
+
+            /// \internal
+            /// \brief Releases the files and the expanded arguments (keeps the capacity).
+            void clear() noexcept {
+                _args.clear();
+                _files.clear();
+                _unreadable.clear();
+                _tail = npos;
+            }
+
+        private:
+            /// \internal
+            /// \brief Adds an argument, or the arguments of a response file.
+            void add(std::string_view arg, std::pmr::vector<parse_error>& errors, std::size_t depth) {
+                if (arg.size() < 2 or arg.front() != '@') {
+                    _args.push_back(arg);
+                    return;
+                }
+
+                std::pmr::string path(arg.substr(1), _args.get_allocator());
+                mapped_file file;
+                if (depth >= max_depth or not file.open(path.c_str())) {
+                    errors.push_back({ error_kind::response_file, static_cast<std::uint32_t>(_unreadable.size()), parse_error::none });
+                    _unreadable.push_back(arg);
+                    return;
+                }
+
+                char* data = file.data();
+                std::size_t size = file.size();
+                _files.push_back(std::move(file)); // the contents do not move
+
+                tokenize(data, data + size, [&](std::string_view token) {
+                    add(token, errors, depth + 1);
+                });
+            }
+
+            std::pmr::vector<mapped_file> _files; ///< Mapped response files.
+            std::pmr::vector<std::string_view> _args; ///< Expanded arguments.
+            std::pmr::vector<std::string_view> _unreadable; ///< Response files that could not be read.
+            std::size_t _tail = npos; ///< Number of arguments after the `--` given in argv.
+        };
+
+        /**
+         *  \internal
+         *  \brief Prefix trie over a set of words (\ref clipper::complete()).
+         *
+         *  The words are kept sorted and every node stores the range of the words that start with its prefix,
+         *  so a query walks down the prefix and reads the candidates from that range.
+         *  The children of a node are next to each other in one array, and their labels are in a parallel
+         *  array of characters, so choosing an edge is a scan over a few contiguous bytes.
+         */
+        class completion_trie {
+        public:
+            explicit completion_trie(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                : _words(resource), _nodes(resource), _labels(resource) {}
+
+            /// \internal
+            /// \brief Builds the trie (the words have to outlive it, duplicates and empty ones are dropped).
+            void build(std::span<const std::string_view> words) {
+                _words.assign(words.begin(), words.end());
+                sort(0, _words.size(), 0);
+                _words.erase(std::unique(_words.begin(), _words.end()), _words.end());
+                if (not _words.empty() and _words.front().empty())
+                    _words.erase(_words.begin());
+
+                _nodes.clear();
+                _labels.clear();
+                _nodes.push_back({ 0, 0, 0, static_cast<std::uint32_t>(_words.size()) });
+                _labels.push_back('\0');
+                build(0, 0);
+            }
+
+            /// \internal
+            /// \brief Calls emit with every word that starts with the prefix (in order).
+            template<typename F>
+            void find(std::string_view prefix, F&& emit) const {
+                if (_nodes.empty())
+                    return;
+
+                std::uint32_t n = 0;
+                for (char c : prefix) {
+                    const node& nd = _nodes[n];
+                    const char* first = _labels.data() + nd.child;
+                    const char* last = first + nd.children;
+                    const char* it = std::find(first, last, c);
+                    if (it == last)
+                        return;
+                    n = static_cast<std::uint32_t>(it - _labels.data());
+                }
+
+                for (std::uint32_t i = _nodes[n].first; i < _nodes[n].last; i++)
+                    emit(_words[i]);
+            }
+
+            /// \internal
+            /// \brief Gets the number of nodes.
+            std::size_t size() const noexcept
+            { return _nodes.size(); }
+
+        private:
+            /// \brief Trie node (the prefix is the path from the root).
+            struct node {
+                std::uint32_t child; ///< Index of the first child.
+                std::uint32_t children; ///< Number of children.
+                std::uint32_t first; ///< First word with the prefix.
+                std::uint32_t last; ///< End of the words with the prefix.
+            };
+
+            /// \brief Gets the character of a word at a position (-1 past its end, so shorter words come first).
+            int char_at(std::size_t word, std::size_t depth) const noexcept {
+                return depth < _words[word].size() ? static_cast<unsigned char>(_words[word][depth]) : -1;
+            }
+
+            /**
+             *  \brief Sorts the words (multikey quicksort).
+             *
+             *  The words of the range share the first depth characters, so only the next character is compared,
+             *  which is cheaper than comparing whole words when many of them share long prefixes.
+             */
+            void sort(std::size_t lo, std::size_t hi, std::size_t depth) {
+                while (hi - lo > 1) {
+                    const int pivot = char_at(lo + (hi - lo) / 2, depth);
+                    std::size_t lt = lo, i = lo, gt = hi; // [lo, lt) < pivot, [lt, i) == pivot, [gt, hi) > pivot
+                    while (i < gt) {
+                        const int c = char_at(i, depth);
+                        if (c < pivot)
+                            std::swap(_words[lt++], _words[i++]);
+                        else if (c > pivot)
+                            std::swap(_words[i], _words[--gt]);
+                        else
+                            i++;
+                    }
+
+                    sort(lo, lt, depth);
+                    sort(gt, hi, depth);
+                    if (pivot < 0)
+                        return; // the equal words ended
+                    lo = lt;
+                    hi = gt;
+                    depth++;
+                }
+            }
+
+            /// \brief Creates the children of a node (all at once, so they are next to each other).
+            void build(std::uint32_t n, std::size_t depth) {
+                std::uint32_t i = _nodes[n].first;
+                const std::uint32_t end = _nodes[n].last;
+                if (i < end and _words[i].size() == depth) // the word that ends here (comes first)
+                    i++;
+
+                const std::uint32_t child = static_cast<std::uint32_t>(_nodes.size());
+                while (i < end) {
+                    const char c = _words[i][depth];
+                    std::uint32_t j = i + 1;
+                    while (j < end and _words[j][depth] == c)
+                        j++;
+                    _nodes.push_back({ 0, 0, i, j });
+                    _labels.push_back(c);
+                    i = j;
+                }
+
+                const std::uint32_t count = static_cast<std::uint32_t>(_nodes.size()) - child;
+                _nodes[n].child = child;
+                _nodes[n].children = count;
+                for (std::uint32_t k = 0; k < count; k++)
+                    build(child + k, depth + 1);
+            }
+
+            std::pmr::vector<std::string_view> _words; ///< Sorted words.
+            std::pmr::vector<node> _nodes; ///< Nodes (the root first).
+            std::pmr::vector<char> _labels; ///< Edge character of every node.
+        };
+
+        /**
+         *  \internal
+         *  \brief Bounded Levenshtein distance from one word to many others (Myers' bit-vector algorithm, Hyyrö's form).
+         *
+         *  One column of the distance matrix is kept in the bits of two words, so a character of the other word
+         *  costs a few bitwise operations. The match masks of the pattern are computed once for all the comparisons,
+         *  and a comparison stops once the distance cannot get within the bound.
+         */
+        class edit_distance {
+        public:
+            static constexpr std::size_t max_pattern = 64; ///< Maximum pattern length (longer ones match nothing).
+
+            /// \internal
+            /// \brief Prepares the match masks of a pattern.
+            explicit edit_distance(std::string_view pattern) noexcept
+                : _size(pattern.size()) {
+                if (_size > max_pattern)
+                    return;
+                for (std::size_t i = 0; i < _size; i++)
+                    _peq[static_cast<unsigned char>(pattern[i])] |= std::uint64_t { 1 } << i;
+            }
+
+            /**
+             *  \internal
+             *  \brief Computes the distance from the pattern to a word.
+             *  \return Distance, or bound + 1 if it is greater than the bound.
+             */
+            std::size_t operator()(std::string_view word, std::size_t bound) const noexcept {
+                if (_size > max_pattern)
+                    return bound + 1;
+                if (0 == _size)
+                    return word.size() <= bound ? word.size() : bound + 1;
+
+                const std::size_t diff = _size > word.size() ? _size - word.size() : word.size() - _size;
+                if (diff > bound)
+                    return bound + 1;
+
+                const std::uint64_t last = std::uint64_t { 1 } << (_size - 1);
+                std::uint64_t pv = ~std::uint64_t { 0 }, mv = 0;
+                std::size_t score = _size;
+
+                for (std::size_t j = 0; j < word.size(); j++) {
+                    const std::uint64_t eq = _peq[static_cast<unsigned char>(word[j])];
+                    const std::uint64_t xv = eq | mv;
+                    const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+                    std::uint64_t ph = mv | ~(xh | pv);
+                    std::uint64_t mh = pv & xh;
+
+                    if (ph & last)
+                        score++;
+                    else if (mh & last)
+                        score--;
+
+                    if (score > bound + (word.size() - j - 1)) // it decreases by at most one per character
+                        return bound + 1;
+
+                    ph = (ph << 1) | 1;
+                    mh <<= 1;
+                    pv = mh | ~(xv | ph);
+                    mv = ph & xv;
+                }
+
+                return score <= bound ? score : bound + 1;
+            }
+
+        private:
+            std::array<std::uint64_t, 256> _peq { }; ///< Positions of every character in the pattern.
+            std::size_t _size; ///< Pattern length.
+        };
+    } // namespace detail
+
+
+    /**
+     *  \brief Compile-time option name table (constexpr schema).
+     *
+     *  Generates a minimal perfect hash of all option names during compilation,
+     *  so a \ref clipper constructed with it resolves names without building
+     *  (and allocating) a runtime hash map.
+     *  Options have to be added to the \ref clipper in the order they are declared here.
+     *
+     *  \code
+     *  static constexpr CLI::static_schema schema {{
+     *      { "--input", "-i" },
+     *      { "--verbose", "-v" }
+     *  }};
+     *
+     *  CLI::clipper cli(schema);
+     *  \endcode
+     *
+     *  \tparam N Number of options.
+     *  \see option_spec clipper
+     */
+    template<std::size_t N>
+    class static_schema {
+        static constexpr std::size_t capacity = N * 2; ///< Maximum number of names.
+
+    public:
+        /**
+         *  \brief Builds the name table.
+         *  \param specs Option declarations, their position is their slot.
+         */
+        consteval static_schema(const option_spec (&specs)[N]) {
+            for (std::size_t i = 0; i < N; i++) {
+                _specs[i] = specs[i];
+                add_key(specs[i].name, i);
+                if (not specs[i].alt_name.empty() and specs[i].alt_name != specs[i].name)
+                    add_key(specs[i].alt_name, i);
+            }
+            detail::build_name_index(_keys, _count, _table, _displacement);
+        }
+
+        /// \brief Gets the number of declared options.
+        constexpr std::size_t size() const noexcept
+        { return N; }
+
+        /// \brief Gets an option declaration.
+        constexpr const option_spec& operator[](std::size_t slot) const noexcept
+        { return _specs[slot]; }
+
+        /**
+         *  \brief  Finds the slot of an option.
+         *  \param  key Option name.
+         *  \return Slot of the option or \ref detail::npos if there is no such option.
+         */
+        constexpr std::size_t find(std::string_view key) const noexcept
+        { return index().find(key); }
+
+        /// \internal
+        /// \brief Gets an allocation-free view of the table.
+        constexpr detail::static_name_index index() const noexcept
+        { return { _table.data(), _displacement.data(), _count }; }
+
+    private:
+        /// \internal
+        /// \brief Adds a name to the temporary key list.
+        constexpr void add_key(std::string_view key, std::size_t slot) {
+            if (key.empty())
+                detail::schema_error("option name must not be empty");
+
+            _keys[_count++] = { key, slot };
+        }
+
+        std::array<option_spec, N> _specs { }; ///< Option declarations.
+        std::array<detail::name_entry, capacity> _keys { }; ///< Names in declaration order.
+        std::array<detail::name_entry, capacity> _table { }; ///< Perfect hash table.
+        std::array<std::int32_t, capacity> _displacement { }; ///< Bucket displacements.
+        std::size_t _count = 0; ///< Number of names.
+    };
+
+
+    /// \brief Name of an enum value (entry of an \ref enum_table).
+    template<typename E>
+    struct enum_entry {
+        std::string_view name; ///< Name of the value.
+        E value; ///< Value.
+    };
+
+    /**
+     *  \brief Compile-time table of the names of enum values.
+     *
+     *  Names are resolved through a minimal perfect hash generated during compilation
+     *  (the same as the one of \ref static_schema), so converting a value takes two hashes
+     *  and a single string comparison. A value may have more than one name,
+     *  the first one is used to print it.
+     *
+     *  \tparam E Enum type.
+     *  \tparam N Number of names.
+     *  \see enum_names
+     */
+    template<typename E, std::size_t N>
+    class enum_table {
+    public:
+        /**
+         *  \brief Builds the name table.
+         *  \param entries Names and their values.
+         */
+        consteval enum_table(const enum_entry<E> (&entries)[N]) {
+            std::array<detail::name_entry, N> keys { };
+            for (std::size_t i = 0; i < N; i++) {
+                if (entries[i].name.empty())
+                    detail::schema_error("enum name must not be empty");
+
+                _entries[i] = entries[i];
+                keys[i] = { entries[i].name, i };
+            }
+            detail::build_name_index(keys, N, _table, _displacement);
+        }
+
+        /// \brief Gets the number of names.
+        constexpr std::size_t size() const noexcept
+        { return N; }
+
+        /// \brief Gets an entry (in declaration order).
+        constexpr const enum_entry<E>& operator[](std::size_t i) const noexcept
+        { return _entries[i]; }
+
+        /**
+         *  \brief  Finds the value of a name.
+         *  \param  name Name of the value.
+         *  \param[out] out Value (unchanged if there is no such name).
+         *  \return True if the name was found, false otherwise.
+         */
+        constexpr bool find(std::string_view name, E& out) const noexcept {
+            std::size_t i = detail::static_name_index { _table.data(), _displacement.data(), N }.find(name);
+            if (detail::npos == i)
+                return false;
+
+            out = _entries[i].value;
+            return true;
+        }
+
+        /**
+         *  \brief  Gets the name of a value.
+         *  \param  value Enum value.
+         *  \return First name of the value (empty if it has none).
+         */
+        constexpr std::string_view name(E value) const noexcept {
+            for (const enum_entry<E>& e : _entries)
+                if (e.value == value)
+                    return e.name;
+            return { };
+        }
+
+    private:
+        std::array<enum_entry<E>, N> _entries { }; ///< Names in declaration order.
+        std::array<detail::name_entry, N> _table { }; ///< Perfect hash table.
+        std::array<std::int32_t, N> _displacement { }; ///< Bucket displacements.
+    };
+
+
+    namespace detail
+    {
+        /// \internal
+        /// \brief Writes text at compile time, or only measures it (if there is no output).
+        struct text_writer {
+            char* out = nullptr; ///< Output (nullptr to measure).
+            std::size_t size = 0; ///< Length of the written text.
+
+            constexpr text_writer& operator<<(std::string_view str) noexcept {
+                for (char c : str)
+                    put(c);
+                return *this;
+            }
+
+            constexpr text_writer& operator<<(char c) noexcept {
+                put(c);
+                return *this;
+            }
+
+            constexpr void fill(std::size_t count, char c) noexcept {
+                while (count-- > 0)
+                    put(c);
+            }
+
+            constexpr void put(char c) noexcept {
+                if (nullptr != out)
+                    out[size] = c;
+                size++;
+            }
+        };
+
+        /// \internal
+        /// \brief Writes a help entry of an option (the layout of \ref clipper::make_help()).
+        constexpr void write_static_entry(text_writer& w, const option_spec& spec, std::string_view doc) noexcept {
+            const std::size_t start = w.size;
+            w << '\t';
+            if (not spec.alt_name.empty() and spec.alt_name != spec.name)
+                w << spec.alt_name << ", ";
+            w << spec.name << ' ';
+            if (not spec.value.empty())
+                w << '<' << spec.value << '>';
+
+            const std::size_t length = w.size - start - 1;
+            if (CLIPPER_HELP_ARG_FIELD_WIDTH <= length) {
+                w << "\n\t";
+                w.fill(CLIPPER_HELP_ARG_FIELD_WIDTH, ' ');
+            }
+            else {
+                w.fill(CLIPPER_HELP_ARG_FIELD_WIDTH - length, ' ');
+            }
+            w << doc << '\n';
+        }
+
+        /// \internal
+        /// \brief Writes the help text of a static schema (the layout of \ref clipper::make_help()).
+        template<std::size_t N>
+        constexpr void write_static_help(text_writer& w, const static_schema<N>& schema, const app_info& info) noexcept {
+            if (not info.description.empty())
+                w << "DESCRIPTION\n\t" << info.description << "\n\n";
+
+            w << "SYNOPSIS\n\t" << info.name;
+            for (std::size_t i = 0; i < N; i++) {
+                if (schema[i].required) {
+                    w << ' ' << (schema[i].alt_name.empty() ? schema[i].name : schema[i].alt_name) << ' ';
+                    if (not schema[i].value.empty())
+                        w << '<' << schema[i].value << '>';
+                }
+            }
+            w << " [...]\n";
+
+            bool flags = not info.help_flag.name.empty() or not info.version_flag.name.empty();
+            bool options = false;
+            for (std::size_t i = 0; i < N; i++) {
+                flags |= schema[i].value.empty();
+                options |= not schema[i].value.empty();
+            }
+
+            if (flags) {
+                w << "\nFLAGS\n";
+                if (not info.help_flag.name.empty())
+                    write_static_entry(w, info.help_flag, "Displays help");
+                if (not info.version_flag.name.empty())
+                    write_static_entry(w, info.version_flag, "Displays version information");
+                for (std::size_t i = 0; i < N; i++)
+                    if (schema[i].value.empty())
+                        write_static_entry(w, schema[i], schema[i].doc);
+            }
+
+            if (options) {
+                w << "\nOPTIONS\n";
+                for (std::size_t i = 0; i < N; i++)
+                    if (not schema[i].value.empty())
+                        write_static_entry(w, schema[i], schema[i].doc);
+            }
+
+            if (not info.license.empty())
+                w << "\nLICENSE\n\t" << info.license << '\n';
+
+            if (not info.author.empty())
+                w << "\nAUTHOR\n\t" << info.author << '\n';
+
+            if (not info.web_link.empty())
+                w << '\n' << info.web_link << '\n';
+        }
+
+        /// \internal
+        /// \brief Writes the version notice (the layout of \ref clipper::make_version_info()).
+        constexpr void write_static_version(text_writer& w, const app_info& info) noexcept {
+            w << info.name << ' ' << info.version << '\n' << info.author << '\n';
+        }
+
+        /// \internal
+        /// \brief Renders a text into an array at compile time.
+        template<std::size_t Size, typename F>
+        consteval std::array<char, Size> render_static(F write) {
+            std::array<char, Size> text { };
+            text_writer w { text.data() };
+            write(w);
+            return text;
+        }
+    } // namespace detail
+
+
+    /**
+     *  \brief Help and version text of a static schema, generated during compilation.
+     *
+     *  The text has the layout of \ref clipper::make_help(), built from the \ref option_spec "option declarations"
+     *  (value name, documentation, requirement) and the \ref app_info "application information",
+     *  so printing it needs no formatting at all (e.g. a single `write`).
+     *  Both objects have to be declared static constexpr.
+     *
+     *  \code
+     *  static constexpr CLI::static_schema schema {{
+     *      { "--input", "-i", "file", "file to read", true },
+     *      { "--verbose", "-v", { }, "verbose output" }
+     *  }};
+     *  static constexpr CLI::app_info info { .name = "app", .version = "1.0", .help_flag = { "--help", "-h" } };
+     *
+     *  using help = CLI::static_help<schema, info>;
+     *  cli.help_text(help::help_text()); // make_help() and write_help() use it
+     *  \endcode
+     *
+     *  \tparam Schema Static schema.
+     *  \tparam Info Application information.
+     *  \see static_schema clipper::help_text(std::string_view)
+     */
+    template<const auto& Schema, const app_info& Info>
+    struct static_help {
+    private:
+        static constexpr auto write_help = [](detail::text_writer& w) { detail::write_static_help(w, Schema, Info); };
+        static constexpr auto write_version = [](detail::text_writer& w) { detail::write_static_version(w, Info); };
+        static constexpr std::size_t help_size = [] { detail::text_writer w; write_help(w); return w.size; }();
+        static constexpr std::size_t version_size = [] { detail::text_writer w; write_version(w); return w.size; }();
+
+    public:
+        static constexpr std::array<char, help_size> help = detail::render_static<help_size>(write_help); ///< Help text (not null-terminated).
+        static constexpr std::array<char, version_size> version = detail::render_static<version_size>(write_version); ///< Version notice (not null-terminated).
+
+        /// \brief Gets the help text.
+        static constexpr std::string_view help_text() noexcept
+        { return { help.data(), help.size() }; }
+
+        /// \brief Gets the version notice.
+        static constexpr std::string_view version_text() noexcept
+        { return { version.data(), version.size() }; }
+    };
+
+
+    /**
+     *  \brief Compile-time declaration of a struct member bound to an option (\ref struct_parser).
+     *
+     *  A bool member is a flag, a std::vector member collects the values of every occurrence of the option.
+     *
+     *  \tparam S Struct type.
+     *  \tparam Tp Member type (bool or one of the \ref option_types).
+     */
+    template<typename S, typename Tp>
+        requires (std::is_same_v<Tp, bool> or option_types<Tp>)
+    struct field {
+        using struct_type = S; ///< Struct type.
+        using value_type = Tp; ///< Member type.
+        using element_type = typename std::conditional_t<is_vector_v<Tp>, Tp, std::vector<Tp>>::value_type; ///< Type of a single value.
+        using predicate = bool (*)(const element_type&); ///< Type of function that checks a value.
+
+        /// \brief Declares a member bound to an option with a name and an alternative name.
+        constexpr field(std::string_view nm, std::string_view anm, Tp S::* mem, std::string_view doc = { }, predicate pred = nullptr) noexcept
+            : name(nm), alt_name(anm), member(mem), doc(doc), pred(pred) {}
+
+        /// \brief Declares a member bound to an option with a name.
+        constexpr field(std::string_view nm, Tp S::* mem, std::string_view doc = { }, predicate pred = nullptr) noexcept
+            : name(nm), member(mem), doc(doc), pred(pred) {}
+
+        /// \brief Makes the option required.
+        /// \return Copy of the declaration.
+        constexpr field req() const noexcept {
+            field f = *this;
+            f.required = true;
+            return f;
+        }
+
+        std::string_view name; ///< Option name.
+        std::string_view alt_name { }; ///< Alternative name (optional).
+        Tp S::* member; ///< Bound member.
+        std::string_view doc { }; ///< Documentation.
+        predicate pred { nullptr }; ///< Function that checks every value (optional).
+        bool required { false }; ///< True if the option is required.
+    };
+
+
+    /**
+     *  \brief Parser generated at compile time from a table of \ref field "struct fields".
+     *
+     *  The names are looked up in a \ref static_schema, every slot has its own conversion function generated
+     *  for the member type, and the values are written straight through the member pointers.
+     *  No option objects are created and parsing does not allocate (unless errors are collected or vectors grow).
+     *  Values can be attached with `=`, clusters of one-character names and response files are not supported.
+     *
+     *  \code
+     *  struct config { std::string input; int jobs = 1; bool verbose = false; };
+     *
+     *  static constexpr std::tuple fields {
+     *      CLI::field { "--input", "-i", &config::input, "file to read" }.req(),
+     *      CLI::field { "--jobs", "-j", &config::jobs, "number of jobs", CLI::pred::between<1, 64> },
+     *      CLI::field { "--verbose", "-v", &config::verbose }
+     *  };
+     *
+     *  config cfg;
+     *  if (not CLI::struct_parser<fields>::parse(argc, argv, cfg)) ...
+     *  \endcode
+     *
+     *  \tparam Fields Table of fields (a static constexpr std::tuple of \ref field of the same struct).
+     */
+    template<const auto& Fields>
+    class struct_parser {
+        using fields_type = std::remove_cvref_t<decltype(Fields)>;
+        using argv_ptr = const char* const*; ///< Type of an array with arguments pointer.
+
+    public:
+        static constexpr std::size_t size = std::tuple_size_v<fields_type>; ///< Number of fields.
+        static_assert(size > 0, "The field table must not be empty");
+        using struct_type = typename std::tuple_element_t<0, fields_type>::struct_type; ///< Struct type.
+
+    private:
+        /// \internal
+        /// \brief Gets a field of the table.
+        template<std::size_t I>
+        static constexpr const auto& get() noexcept
+        { return std::get<I>(Fields); }
+
+        /// \internal
+        /// \brief Type of a conversion function (converts, checks and assigns a value).
+        using assign_fn = assign_status (*)(struct_type&, std::string_view) noexcept;
+
+        /// \internal
+        /// \brief Converts, checks and assigns a value of a field.
+        template<std::size_t I>
+        static assign_status assign(struct_type& out, std::string_view val) noexcept {
+            constexpr const auto& f = get<I>();
+            using field_type = std::remove_cvref_t<decltype(f)>;
+            using Tp = typename field_type::value_type;
+            using E = typename field_type::element_type;
+            static_assert(std::is_same_v<typename field_type::struct_type, struct_type>, "All fields must belong to the same struct");
+
+            if constexpr (std::is_same_v<Tp, bool>) {
+                out.*(f.member) = true;
+            }
+            else {
+                E value { };
+                if (option<E>::convert(val, value) != assign_status::ok)
+                    return assign_status::invalid_value;
+                if (nullptr != f.pred and not f.pred(value))
+                    return assign_status::not_allowed;
+
+                if constexpr (is_vector_v<Tp>)
+                    (out.*(f.member)).push_back(std::move(value));
+                else
+                    out.*(f.member) = std::move(value);
+            }
+            return assign_status::ok;
+        }
+
+        /// \internal
+        /// \brief Creates the option declarations (value names are not known, all of them are "value").
+        static consteval static_schema<size> make_schema() {
+            option_spec specs[size];
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((specs[I] = { get<I>().name, get<I>().alt_name,
+                               std::is_same_v<typename std::remove_cvref_t<decltype(get<I>())>::value_type, bool> ? std::string_view() : "value",
+                               get<I>().doc, get<I>().required }), ...);
+            }(std::make_index_sequence<size>{ });
+            return static_schema<size>(specs);
+        }
+
+        static constexpr std::array<assign_fn, size> assigners = []<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<assign_fn, size> { &assign<I>... };
+        }(std::make_index_sequence<size>{ }); ///< Conversion function of every slot.
+
+    public:
+        /// \brief Option declarations and the name table (e.g. for \ref static_help).
+        static constexpr static_schema<size> schema = make_schema();
+
+        /**
+         *  \brief Parses the command line input into a struct.
+         *
+         *  Members of the options that are not given are left as they are.
+         *
+         *  \param argc Argument count.
+         *  \param argv Arguments.
+         *  \param[out] out Struct the values are written to.
+         *  \param[out] errors Parsing errors (optional).
+         *  \return True if arguments were parsed successfully, false otherwise.
+         *  \see format_error()
+         */
+        static bool parse(arg_count argc, argv_ptr argv, struct_type& out, std::pmr::vector<parse_error>* errors = nullptr) {
+            std::array<bool, size> given { };
+            bool ok = true;
+            auto fail = [&](error_kind kind, std::size_t index, std::size_t slot) {
+                ok = false;
+                if (nullptr != errors)
+                    errors->push_back({ kind, static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(slot) });
+            };
+
+            const auto count = static_cast<std::size_t>(argc);
+            for (std::size_t i = 1; i < count; i++) {
+                const std::size_t start = i;
+                std::string_view arg = argv[i], value;
+                std::size_t slot = schema.find(arg);
+
+                if (detail::npos == slot) {
+                    const std::size_t eq = arg.find('=');
+                    if (eq != std::string_view::npos and eq > 0)
+                        slot = schema.find(arg.substr(0, eq));
+                    if (detail::npos == slot or schema[slot].value.empty()) {
+                        fail(error_kind::unknown_argument, i, parse_error::none);
+                        continue;
+                    }
+                    value = arg.substr(eq + 1);
+                }
+                else if (not schema[slot].value.empty()) {
+                    if (i + 1 >= count) {
+                        fail(error_kind::missing_value, i, slot);
+                        continue;
+                    }
+                    value = argv[++i];
+                }
+
+                given[slot] = true;
+                const assign_status status = assigners[slot](out, value);
+                if (status != assign_status::ok)
+                    fail(status == assign_status::invalid_value ? error_kind::invalid_value : error_kind::not_allowed, start, slot);
+            }
+
+            for (std::size_t slot = 0; slot < size; slot++)
+                if (schema[slot].required and not given[slot])
+                    fail(error_kind::missing_required, parse_error::none, slot);
+            return ok;
+        }
+
+        /**
+         *  \brief Creates a message describing a parsing error (as \ref clipper::format_error() does).
+         *  \param err Parsing error.
+         *  \param argc Argument count.
+         *  \param argv Arguments given to \ref parse().
+         */
+        static std::string format_error(const parse_error& err, arg_count argc, argv_ptr argv) {
+            auto arg = [&](std::size_t index) {
+                return index < static_cast<std::size_t>(argc) ? std::string_view(argv[index]) : std::string_view();
+            };
+
+            switch (err.kind) {
+            case error_kind::unknown_argument:
+                return std::string("[").append(arg(err.index)).append("] Unkonown argument");
+            case error_kind::missing_value:
+                return std::string("[").append(arg(err.index)).append("] Missing option value");
+            case error_kind::invalid_value:
+            case error_kind::not_allowed: {
+                const option_spec& spec = schema[err.slot];
+                std::string_view name = arg(err.index), value;
+                if (schema.find(name) != detail::npos) {
+                    value = arg(err.index + 1);
+                }
+                else {
+                    value = name.substr(name.find('=') + 1);
+                    name = name.substr(0, name.find('='));
+                }
+
+                std::string msg = std::string("[").append(name).append("] Value ").append(value).append(" is not allowed \n\t{ ");
+                if (not spec.alt_name.empty() and spec.alt_name != spec.name)
+                    msg.append(spec.alt_name).append(", ");
+                return msg.append(spec.name).append(" <").append(spec.value).append(">  ").append(spec.doc).append(" }");
+            }
+            case error_kind::missing_required:
+                return std::string("[").append(schema[err.slot].alt_name.empty() ? schema[err.slot].name : schema[err.slot].alt_name)
+                    .append("] Missing required argument");
+            default:
+                return { };
+            }
+        }
+    };
+
+
+    /**
+     *  \brief Results of parsing command line input against a \ref clipper (schema).
+     *
+     *  Holds everything a parse produces (given options, their values and errors),
+     *  so one \ref clipper can be shared by many threads, each parsing into its own result.
+     *  Values are views into the parsed arguments, which have to outlive the result.
+     *  A result can be reused, its memory is kept between parses.
+     *
+     *  \see clipper::parse(arg_count, argv_ptr, parse_result&) const
+     */
+    class parse_result {
+        friend class clipper;
+
+    public:
+        /// \brief Default constructor.
+        parse_result() = default;
+
+        /// \brief Constructs an empty result that allocates from a memory resource.
+        explicit parse_result(std::pmr::memory_resource* resource)
+            : _given(resource), _values(resource), _errors(resource), _response(resource) {}
+
+        /**
+         *  \brief Checks whether the arguments were parsed successfully.
+         *  \return True if there were no errors, false otherwise.
+         */
+        bool ok() const noexcept
+        { return _ok; }
+
+        /// \copydoc ok()
+        explicit operator bool() const noexcept
+        { return _ok; }
+
+        /**
+         *  \brief Checks if no arguments were given.
+         *  \return True if no arguments were given, false otherwise.
+         */
+        bool no_args() const noexcept
+        { return _argc < 2; }
+
+        /// \brief Checks whether the help flag was used.
+        bool help() const noexcept
+        { return _help; }
+
+        /// \brief Checks whether the version flag was used.
+        bool version() const noexcept
+        { return _version; }
+
+        /**
+         *  \brief Checks whether an option was given.
+         *  \param name Name of the option.
+         *  \return True if the option was given, false otherwise (also if there is no such option).
+         */
+        bool is_set(std::string_view name) const noexcept;
+
+        /**
+         *  \brief Gets the (last) value given to an option as it was in the arguments.
+         *  \param name Name of the option.
+         *  \return Value of the option or an empty view if it was not given.
+         */
+        std::string_view value(std::string_view name) const noexcept;
+
+        /**
+         *  \brief  Gets the (last) value given to an option.
+         *  \tparam Tp Option type (the same as the type of the option added to the schema).
+         *  \param  name Name of the option.
+         *  \return Value of the option, or nothing if the option was not given (or is of a different type).
+         */
+        template<option_types Tp>
+        std::optional<Tp> get(std::string_view name) const;
+
+        /**
+         *  \brief  Gets the (last) value given to an option, with the reason if it cannot be used.
+         *
+         *  In \ref lazy() "lazy" mode the value is converted and validated here (on every call),
+         *  otherwise that was done while parsing and it is only converted.
+         *
+         *  \tparam Tp Option type (the same as the type of the option added to the schema).
+         *  \param  name Name of the option.
+         *  \param[out] out Value of the option (not modified if the option was not given or the value is wrong).
+         *  \return \ref assign_status (\ref assign_status::ok also if the option was not given,
+         *          \ref assign_status::invalid_value if it is of a different type).
+         */
+        template<option_types Tp>
+        assign_status read(std::string_view name, Tp& out) const;
+
+        /**
+         *  \brief Sets whether option values are converted and validated while parsing or on access.
+         *
+         *  In lazy mode parsing only records the values, so a value that cannot be converted
+         *  or is not allowed is not a parsing error. It is reported by \ref read() (and \ref get())
+         *  when the option is read. Unknown arguments, missing values, required options and constraint groups
+         *  are still checked while parsing. The default is strict.
+         *
+         *  \param enable True to defer the conversion, false to validate all the values while parsing.
+         *  \return Reference to itself.
+         */
+        parse_result& lazy(bool enable = true) noexcept {
+            _lazy = enable;
+            return *this;
+        }
+
+        /// \brief Checks whether option values are converted on access (\ref lazy(bool) "see more").
+        bool lazy() const noexcept
+        { return _lazy; }
+
+        /**
+         *  \brief Gets a list of parsing errors.
+         *  \return Reference to a vector that contains all parsing errors.
+         *  \see format_error()
+         */
+        const std::pmr::vector<parse_error>& errors() const noexcept
+        { return _errors; }
+
+        /**
+         *  \brief Creates a message describing a parsing error.
+         *  \param err Error of this result.
+         *  \return Error message.
+         *  \see errors()
+         */
+        std::string format_error(const parse_error& err) const;
+
+        /**
+         *  \brief Gets the arguments given after `--`.
+         *  \return Arguments after `--`, a view into argv (empty if there was none).
+         *  \see clipper::passthrough()
+         */
+        std::span<const char* const> passthrough() const noexcept
+        { return _passthrough; }
+
+        /// \brief Clears the result (keeps the capacity and the \ref lazy(bool) "mode").
+        void clear() noexcept {
+            _given.clear();
+            _errors.clear();
+            _passthrough = { };
+            _args = { };
+            _argc = 0;
+            _ok = _help = _version = false;
+        }
+
+    private:
+        /// \internal
+        /// \brief Gets the slot of a given option.
+        std::size_t given_slot(std::string_view name) const noexcept;
+
+        /// \internal
+        /// \brief Converts (and validates in lazy mode) the value of a given option.
+        template<option_types Tp>
+        assign_status read_slot(std::size_t slot, Tp& out) const;
+
+        const clipper* _schema = nullptr; ///< Schema that the arguments were parsed against.
+        detail::arg_list _args; ///< Parsed arguments.
+        arg_count _argc = 0; ///< Argument count.
+        detail::slot_set _given; ///< Given options.
+        std::pmr::vector<std::string_view> _values; ///< Last value of every option (indexed by slot).
+        std::pmr::vector<parse_error> _errors; ///< Parsing errors.
+        bool _ok = false; ///< Parsing result.
+        bool _help = false; ///< True if the help flag was used.
+        bool _version = false; ///< True if the version flag was used.
+        bool _lazy = false; ///< True if the values are converted on access.
+        std::span<const char* const> _passthrough; ///< Arguments after `--`.
+        detail::response_files _response; ///< Arguments expanded from response files (values refer to them).
+    };
+
+
+    /**
+     *  \brief Results of parsing many command lines (one per line of a buffer) against a \ref clipper (schema).
+     *
+     *  Values are stored by columns, one array per option with a value for every line
+     *  (an empty view if the option was not given), they refer to the buffer owned by the result.
+     *  Errors are kept only for the lines that failed.
+     *
+     *  \see clipper::parse_batch()
+     */
+    class batch_result {
+        friend class clipper;
+
+    public:
+        /// \brief Default constructor.
+        batch_result() = default;
+
+        /// \brief Constructs an empty result that allocates from a memory resource.
+        explicit batch_result(std::pmr::memory_resource* resource)
+            : _buffer(resource), _values(resource), _given(resource), _failed(resource), _failures(resource), _errors(resource), _args(resource) {}
+
+        /**
+         *  \brief Checks whether all the lines were parsed successfully.
+         *  \return True if there were no errors, false otherwise.
+         */
+        bool ok() const noexcept
+        { return _ok; }
+
+        /// \copydoc ok()
+        explicit operator bool() const noexcept
+        { return _ok; }
+
+        /**
+         *  \brief Checks whether a line was parsed successfully.
+         *  \param line Line index.
+         */
+        bool ok(std::size_t line) const noexcept
+        { return line < _lines and nullptr == find_failure(line); }
+
+        /// \brief Gets the number of parsed lines.
+        std::size_t size() const noexcept
+        { return _lines; }
+
+        /**
+         *  \brief Gets the lines that were not parsed successfully.
+         *  \return Reference to a vector of line indices (ascending).
+         */
+        const std::pmr::vector<std::size_t>& failed() const noexcept
+        { return _failed; }
+
+        /**
+         *  \brief Gets the parsing errors of a line.
+         *  \param line Line index.
+         *  \return Errors of the line (empty if it was parsed successfully, or if no arguments were given).
+         *  \see format_error()
+         */
+        std::span<const parse_error> errors(std::size_t line) const noexcept {
+            const failure* f = find_failure(line);
+            return nullptr == f ? std::span<const parse_error>() : std::span(_errors).subspan(f->first_error, f->error_count);
+        }
+
+        /**
+         *  \brief Creates a message describing a parsing error.
+         *  \param line Line index.
+         *  \param err Error of the line.
+         *  \return Error message.
+         */
+        std::string format_error(std::size_t line, const parse_error& err) const;
+
+        /**
+         *  \brief Gets the values given to an option on every line (the last one, as it was in the line).
+         *  \param name Name of the option.
+         *  \return Values indexed by line (empty if there is no such option).
+         */
+        std::span<const std::string_view> column(std::string_view name) const noexcept;
+
+        /**
+         *  \brief Checks whether an option was given on a line.
+         *  \param line Line index.
+         *  \param name Name of the option.
+         */
+        bool is_set(std::size_t line, std::string_view name) const noexcept;
+
+        /**
+         *  \brief Gets the (last) value given to an option on a line as it was in the line.
+         *  \return Value of the option or an empty view if it was not given.
+         */
+        std::string_view value(std::size_t line, std::string_view name) const noexcept;
+
+        /**
+         *  \brief  Gets the (last) value given to an option on a line.
+         *  \tparam Tp Option type (the same as the type of the option added to the schema).
+         *  \return Value of the option, or nothing if the option was not given (or is of a different type).
+         */
+        template<option_types Tp>
+        std::optional<Tp> get(std::size_t line, std::string_view name) const;
+
+        /// \brief Clears the result (keeps the capacity).
+        void clear() noexcept {
+            _file = { };
+            _buffer.clear();
+            _values.clear();
+            _given.clear();
+            _failed.clear();
+            _failures.clear();
+            _errors.clear();
+            _args.clear();
+            _lines = 0;
+            _ok = false;
+        }
+
+    private:
+        /// \internal
+        /// \brief Line that was not parsed successfully.
+        struct failure {
+            std::size_t line; ///< Line index.
+            std::uint32_t first_error, error_count; ///< Errors of the line.
+            std::uint32_t first_arg, arg_count; ///< Arguments of the line (to format the errors).
+        };
+
+        /// \internal
+        /// \brief Finds the failure record of a line.
+        const failure* find_failure(std::size_t line) const noexcept {
+            auto it = std::lower_bound(_failed.begin(), _failed.end(), line);
+            return it == _failed.end() or *it != line ? nullptr : &_failures[static_cast<std::size_t>(it - _failed.begin())];
+        }
+
+        /// \internal
+        /// \brief Gets the slot of an option (npos if there is no such option).
+        std::size_t find_slot(std::string_view name) const noexcept;
+
+        const clipper* _schema = nullptr; ///< Schema that the lines were parsed against.
+        detail::mapped_file _file; ///< Parsed file (if the lines were read from a file).
+        std::pmr::vector<char> _buffer; ///< Copy of the parsed lines (if given as a buffer).
+        std::size_t _lines = 0; ///< Number of lines.
+        std::pmr::vector<std::string_view> _values; ///< Values, a column of every option (slot * lines + line).
+        std::pmr::vector<unsigned char> _given; ///< Given options (the same layout as the values).
+        std::pmr::vector<std::size_t> _failed; ///< Lines that failed (ascending).
+        std::pmr::vector<failure> _failures; ///< Failure records (in the order of the failed lines).
+        std::pmr::vector<parse_error> _errors; ///< Errors of the failed lines.
+        std::pmr::vector<std::string_view> _args; ///< Arguments of the failed lines.
+        bool _ok = false; ///< Parsing result.
+    };
+
+
+    /**
+     *  \brief Holds all the CLI information and performs the most important actions.
+     * 
+     * This class is practically the only interface of the clipper library,
+     * that is meant to be directly used.
+     * It holds the neccessary and optional information about
+     * the application, options and flags.
+     * 
+     * Basically everything you need.
+     * 
+     *  \see \ref index "Main Page" option<bool> option<Tp> option_types
+     */
+    class clipper {
+        friend class parse_result;
+        friend class batch_result;
+        using argv_ptr = const char* const* const; ///< Type of an array with arguments pointer.
+        struct token { std::string_view option, value; }; ///< Cli option token (option name + value, empty for flags).
+        static constexpr std::size_t batch_chunk = 256; ///< Number of lines a thread takes at once (\ref parse_batch()).
+        static constexpr std::size_t max_suggestions = 3; ///< Maximum number of names or values suggested in an error message.
+
+        /// \brief Kind of a constraint group.
+        enum class group_kind : unsigned char {
+            exclusive, ///< At most one of the options can be given.
+            one_of,    ///< At least one of the options has to be given.
+            all_of     ///< All of the options have to be given if any of them is.
+        };
+
+        /// \brief Arguments given to parse (that the passthrough arguments refer to).
+        struct argv_source {
+            const char* const* argv; ///< Arguments.
+            std::size_t argc; ///< Argument count.
+            bool expanded; ///< True if the arguments were expanded from response files.
+            std::size_t tail; ///< Number of arguments after the `--` in argv (if expanded).
+        };
+
+        /// \brief Subcommand (\ref add_command()).
+        struct command_entry {
+            std::string_view name; ///< Command name.
+            std::string_view description; ///< Command description.
+            void (*setup)(void*, clipper&); ///< Calls the setup function.
+            void* callable; ///< Setup function (owned by the arena).
+            clipper* instance; ///< Subcommand instance (owned by the arena), nullptr until it is first selected.
+        };
+
+        /// \brief Options that are checked together.
+        struct group {
+            group_kind kind; ///< Type of the constraint.
+            detail::slot_set slots; ///< Options of the group.
+        };
+
+    public:
+        /// \brief Default constructor.
+        clipper() = default;
+
+        /**
+         *  \brief Constructs a clipper instance that allocates from a memory resource.
+         *
+         *  Options, names, documentation and errors are all allocated from the resource,
+         *  e.g. a std::pmr::monotonic_buffer_resource over a stack buffer.
+         *  The resource must outlive the instance.
+         *
+         *  \param resource Memory resource.
+         */
+        explicit clipper(std::pmr::memory_resource* resource)
+            : _resource(resource) {}
+
+        /// \brief Constructs a clipper instance and sets the app name.
+        /// \param resource Memory resource (has to outlive the instance).
+        clipper(std::string_view app_name, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : _resource(resource), _app_name(app_name) {}
+
+        /// \brief Constructs a clipper instance and sets the app name and other information.
+        /// \param resource Memory resource (has to outlive the instance).
+        clipper(std::string_view app_name, std::string_view version, std::string_view author, std::string_view license_notice,
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : _resource(resource), _app_name(app_name), _version(version), _author(author), _license_notice(license_notice) {}
+
+        /**
+         *  \brief Constructs a clipper instance that resolves option names through a compile-time table.
+         *
+         *  No runtime name index is built, options have to be added in the order declared in the schema.
+         *  The schema must outlive the instance (declare it as static constexpr).
+         *
+         *  \param schema Compile-time option name table.
+         *  \param resource Memory resource (has to outlive the instance).
+         *  \see static_schema
+         */
+        template<std::size_t N>
+        clipper(const static_schema<N>& schema, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : _resource(resource), _static_names(schema.index()), _static_size(N) {
+            _options.reserve(N);
+        }
+
+        /// \copydoc clipper(const static_schema<N>&, std::pmr::memory_resource*)
+        /// \param app_name Application name.
+        template<std::size_t N>
+        clipper(std::string_view app_name, const static_schema<N>& schema, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : clipper(schema, resource) {
+            _app_name = app_name;
+        }
+
+        /// \brief Default destructor.
+        ~clipper() = default;
+
+        /**
+         *  \brief  Gets the memory resource that the instance allocates from.
+         *  \return Memory resource pointer.
+         */
+        std::pmr::memory_resource* resource() const noexcept {
+            return _resource;
+        }
+
+        /**
+         *  \brief  Sets the (application) name.
+         *  \return Reference to itself.
+         */
+        clipper& name(std::string_view name) noexcept {
+            _app_name = name;
+            help_changed();
+            return *this;
+        }
+
+        /**
+         *  \brief  Gets the (application) name.
+         *  \return Application name.
+         */
+        std::string_view name() const noexcept {
+            return _app_name;
+        }
+
+        /**
+         *  \brief  Sets the description.
+         *  \return Reference to itself.
+         */
+        clipper& description(std::string_view description) noexcept {
+            _app_description = description;
+            help_changed();
+            return *this;
+        }
+
+        /**
+         *  \brief 	Gets the description.
+         *  \return Description reference.
+         */
+        std::string_view description() const noexcept {
+            return _app_description;
+        }
+
+        /**
+         *  \brief  Sets the version.
+         *  \return Reference to itself.
+         */
+        clipper& version(std::string_view version) noexcept {
+            _version = version;
+            return *this;
+        }
+
+        /**
+         *  \brief  Gets the version.
+         *  \return Version reference.
+         */
+        std::string_view version() const noexcept {
+            return _version;
+        }
+
+        /**
+         *  \brief  Sets the author.
+         *  \return Reference to itself.
+         */
+        clipper& author(std::string_view name) noexcept {
+            _author = name;
+            help_changed();
+            return *this;
+        }
+
+        /**
+         *  \brief  Gets the author.
+         *  \return Author reference.
+         */
+        std::string_view author() const noexcept {
+            return _author;
+        }
+
+        /**
+         *  \brief  Sets the license notice.
+         *  \return Reference to itself.
+         */
+        clipper& license(std::string_view license_notice) noexcept {
+            _license_notice = license_notice;
+            help_changed();
+            return *this;
+        }
+
+        /**
+         *  \brief 	Gets the license notice.
+         *  \return License notice reference.
+         */
+        std::string_view license() const noexcept {
+            return _license_notice;
+        }
+
+        /**
+         *  \brief  Sets the web link.
+         *  \return Reference to itself.
+         */
+        clipper& web_link(std::string_view link) noexcept {
+            _web_link = link;
+            help_changed();
+            return *this;
+        }
+
+        /**
+         *  \brief  Gets the web link.
+         *  \return Web link reference.
+         */
+        std::string_view web_link() const noexcept {
+            return _web_link;
+        }
+
+        /**
+         *  \brief  Adds an option of a given type.
+         *  \tparam Tp Option (option value) type.
+         *  \param  name Option name.
+         *  \return Reference to the created option.
+         *  \see    option_types option<Tp>
+         */
+        template<option_types Tp>
+        option<Tp>& add_option(std::string_view name) {
+            add_name(name);
+            auto& opt = _arena.create<option<Tp>>(name, _resource);
+            _options.push_back(&opt);
+            added();
+            return opt;
+        }
+
+        /**
+         *  \brief  Adds an option of a given type.
+         *  \tparam Tp Option (option value) type.
+         *  \param  name Primary option name.
+         *  \param  alt_name Secondary option name.
+         *  \return Reference to the created option.
+         *  \see    option_types option<Tp>
+         */
+        template<option_types Tp>
+        option<Tp>& add_option(std::string_view name, std::string_view alt_name) {
+            add_name(name);
+            add_name(alt_name);
+
+            auto& opt = _arena.create<option<Tp>>(name, alt_name, _resource);
+            _options.push_back(&opt);
+            added();
+            return opt;
+        }
+
+        /**
+         *  \brief  Adds a positional argument of a given type.
+         *
+         *  Arguments that are not options are assigned to the positional arguments in the order they were added,
+         *  the name is used only in the help message, errors and to read the value from a \ref parse_result.
+         *  Unknown arguments starting with '-' are errors, except `-` and negative numbers.
+         *  With a \ref static_schema they have to be added after all the declared options.
+         *
+         *  \tparam Tp Argument (value) type.
+         *  \param  name Argument name.
+         *  \return Reference to the created argument (configured like an option).
+         *  \see    option_types option<Tp> passthrough()
+         */
+        template<option_types Tp>
+            requires (not std::is_same_v<Tp, bool>)
+        option<Tp>& add_positional(std::string_view name) {
+            if (_options.size() < _static_size)
+                CLIPPER_THROW(std::logic_error("Positional arguments have to be added after the options of the static schema"));
+
+            auto& opt = _arena.create<option<Tp>>(name, _resource);
+            _positionals.push_back(static_cast<std::uint32_t>(_options.size()));
+            _options.push_back(&opt);
+            added();
+            return opt;
+        }
+
+        /**
+         *  \brief  Adds a \ref option< bool > "flag (option<bool>)".
+         * 
+         *  This function adds new \ref option< bool > "flag (option<bool>)".
+         *  Internally it just calls \ref add_option() "add_option<bool>(...)".
+         * 
+         *  \param  name Flag name.
+         *  \return Reference to the created flag.
+         *  \see    option<bool>
+         */
+        option<bool>& add_flag(std::string_view name) {
+            return add_option<bool>(name);
+        }
+
+        /**
+         *  \brief  Adds a \ref option< bool > "flag (option<bool>)".
+         * 
+         *  This function adds new \ref option< bool > "flag (option<bool>)".
          *  Internally it just calls \ref add_option() "add_option<bool>(...)".
          * 
          *  \param  name Flag name.
+         *  \param  alt_name Secondary flag name.
          *  \return Reference to the created flag.
          *  \see    option<bool>
          */
-        option<bool>& add_flag(std::string_view name) {
-            return add_option<bool>(name);
+        option<bool>& add_flag(std::string_view name, std::string_view alt_name) {
+            return add_option<bool>(name, alt_name);
+        }
+
+        /**
+         *  \brief  Adds a subcommand.
+         *
+         *  The subcommand is a separate \ref clipper instance, created when it is selected
+         *  (the first argument that is neither an option nor a value). Its options are added by the setup
+         *  function, that is called with the new instance. Until then the command costs only its entry,
+         *  so it can be one of many in a multi-tool binary. The rest of the arguments are parsed by the subcommand,
+         *  use \ref command() to get it. It shares the help and version flags of this instance.
+         *  Like any instance, it fails without arguments unless the setup function calls \ref allow_no_args().
+         *  Subcommands are dispatched only by \ref parse(arg_count, argv_ptr).
+         *
+         *  \param  name Command name.
+         *  \param  description Command description (shown in the help message of both instances).
+         *  \param  setup Function that adds the options, called with the subcommand instance (`clipper&`).
+         *  \return Reference to itself.
+         *  \see    command()
+         */
+        template<typename F>
+            requires std::invocable<F&, clipper&>
+        clipper& add_command(std::string_view name, std::string_view description, F setup) {
+            F& func = _arena.create<F>(std::move(setup));
+            _commands.push_back({ name, description, [](void* f, clipper& cli) { (*static_cast<F*>(f))(cli); }, &func, nullptr });
+            help_changed();
+            return *this;
+        }
+
+        /// \copydoc add_command(std::string_view, std::string_view, F)
+        template<typename F>
+            requires std::invocable<F&, clipper&>
+        clipper& add_command(std::string_view name, F setup) {
+            return add_command(name, { }, std::move(setup));
+        }
+
+        /**
+         *  \brief  Gets the subcommand selected by the last parse.
+         *  \return Pointer to the subcommand instance, or nullptr if no command was given.
+         *  \see    add_command()
+         */
+        clipper* command() const noexcept {
+            return _selected;
+        }
+
+        /**
+         *  \brief  Gets the arguments given after `--` in the last parse.
+         *
+         *  Nothing after `--` is parsed, the arguments are a view into the argv given to \ref parse()
+         *  (e.g. to pass them on to `execvp`). A `--` inside a response file is an error.
+         *
+         *  \return Arguments after `--` (empty if there was none).
+         */
+        std::span<const char* const> passthrough() const noexcept {
+            return _passthrough;
+        }
+
+        /**
+         *  \brief  Sets/activates the help/version \ref option< bool > "flag (option<bool>)".
+         * 
+         *  Help/Version flag is not a standard flag, it has to be used independently.
+         *  When used with other options is treated as an unknown option.
+         * 
+         *  \param  name Primary flag name.
+         *  \param  alt_name Secondary flag name. (optional)
+         *  \return Help/Version flag reference.
+         *  \see    option<bool>
+         */
+        option<bool>& help_flag(std::string_view name, std::string_view alt_name = "") {
+            _help_flag.hndl = &_arena.create<option<bool>>(name, alt_name, _resource);
+            _help_flag.hndl->doc("Displays help");
+            help_changed();
+            return *_help_flag.hndl;
+        }
+        
+        /// \copydoc help_flag
+        option<bool>& version_flag(std::string_view name, std::string_view alt_name = "") {
+            _version_flag.hndl = &_arena.create<option<bool>>(name, alt_name, _resource);
+            _version_flag.hndl->doc("Displays version information");
+            help_changed();
+            return *_version_flag.hndl;
+        }
+
+        /**
+         *  \brief  Makes the given options mutually exclusive (at most one of them can be used).
+         *  \param  names Names of already added options (at least two).
+         *  \return Reference to itself.
+         */
+        template<typename... Names>
+        clipper& mutually_exclusive(Names... names) {
+            return add_group(group_kind::exclusive, names...);
+        }
+
+        /**
+         *  \brief  Requires one of the given options to be used.
+         *  \param  names Names of already added options (at least two).
+         *  \return Reference to itself.
+         */
+        template<typename... Names>
+        clipper& require_one_of(Names... names) {
+            return add_group(group_kind::one_of, names...);
+        }
+
+        /**
+         *  \brief  Requires all of the given options to be used, if any of them is used.
+         *  \param  names Names of already added options (at least two).
+         *  \return Reference to itself.
+         */
+        template<typename... Names>
+        clipper& require_all_of(Names... names) {
+            return add_group(group_kind::all_of, names...);
+        }
+
+        /**
+         *  \brief  Creates a documentation (man page, help) for the application.
+         *  \return Documentation.
+         *  \see    help_text() write_help()
+         */
+        inline std::string make_help() const noexcept {
+            return std::string(help_text());
+        }
+
+        /**
+         *  \brief  Gets the documentation (man page, help) for the application without copying it.
+         *
+         *  The text is created on the first call and kept until an option, a command or the help information changes.
+         *  Changes made to an already added option (e.g. its documentation) are not tracked, add all the options first.
+         *  Like \ref wrong(), the first call is not thread-safe.
+         *
+         *  \return Documentation (valid until the next change of the instance).
+         */
+        inline std::string_view help_text() const noexcept {
+            if (not _static_help.empty())
+                return _static_help;
+
+            if (not _help_valid) {
+                render_help(_help);
+                _help_valid = true;
+            }
+            return _help;
+        }
+
+        /**
+         *  \brief  Sets a documentation created beforehand (e.g. by \ref static_help), used instead of the generated one.
+         *  \param  text Documentation (has to outlive the instance), empty to generate it again.
+         *  \return Reference to itself.
+         */
+        clipper& help_text(std::string_view text) noexcept {
+            _static_help = text;
+            return *this;
+        }
+
+        /**
+         *  \brief  Writes the documentation into a buffer (like snprintf).
+         *  \param  buffer Output buffer (not null-terminated), can be null if the size is 0.
+         *  \param  size Size of the buffer.
+         *  \return Length of the whole documentation (more than size if it was truncated).
+         */
+        inline std::size_t write_help(char* buffer, std::size_t size) const noexcept {
+            std::string_view text = help_text();
+            if (size != 0)
+                std::memcpy(buffer, text.data(), std::min(size, text.size()));
+            return text.size();
+        }
+
+        /**
+         *  \brief  Writes the documentation to a file (e.g. stdout).
+         *  \return True if the whole documentation was written, false otherwise.
+         */
+        inline bool write_help(std::FILE* file) const noexcept {
+            std::string_view text = help_text();
+            return std::fwrite(text.data(), 1, text.size(), file) == text.size();
+        }
+
+#if CLIPPER_HAS_MMAP
+        /**
+         *  \brief  Writes the documentation to a file descriptor.
+         *  \return True if the whole documentation was written, false otherwise.
+         */
+        inline bool write_help(int fd) const noexcept {
+            std::string_view text = help_text();
+            while (not text.empty()) {
+                ::ssize_t n = ::write(fd, text.data(), text.size());
+                if (n < 0 and errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return false;
+                text.remove_prefix(static_cast<std::size_t>(n));
+            }
+            return true;
+        }
+#endif
+
+        /**
+         *  \brief  Creates a version notice for the application.
+         *  \return Version notice.
+         */
+        inline std::string make_version_info() const noexcept {
+            return
+                std::string(_app_name).append(" ")
+                .append(_version).append("\n")
+                .append(_author).append("\n");
         }
 
         /**
-         *  \brief  Adds a \ref option< bool > "flag (option<bool>)".
-         * 
-         *  This function adds new \ref option< bool > "flag (option<bool>)".
-         *  Internally it just calls \ref add_option() "add_option<bool>(...)".
+         *  \brief Allows the app to be used without any arguments.
          * 
-         *  \param  name Flag name.
-         *  \param  alt_name Secondary flag name.
-         *  \return Reference to the created flag.
-         *  \see    option<bool>
+         *  This function allows for using the app without any arguments (even the ones marked as required).
+         *  When this function is used, there will be no parsing errors when no arguments are given.
+         *  
+         *  \see no_args() parse()
          */
-        option<bool>& add_flag(std::string_view name, std::string_view alt_name) {
-            return add_option<bool>(name, alt_name);
+        inline void allow_no_args() {
+            _allow_no_args = true;
+        }
+
+        /**
+         *  \brief Enables response files.
+         *
+         *  An `@file` argument is replaced with the arguments listed in the file
+         *  (separated with whitespace, quotes and backslash escapes like in a shell, response files can be nested).
+         *  The file is memory-mapped and split in place, values of std::string_view options refer
+         *  to it until the next \ref parse() call (or destruction of the instance).
+         */
+        inline void allow_response_files() {
+            _response_files = true;
+        }
+
+        /**
+         *  \brief Takes the values of options that are not given in the arguments from environment variables.
+         *
+         *  The variable of an option is the prefix followed by its name without the leading dashes, in upper case
+         *  and with '-' and '.' replaced by '_' (`APP_` and `--max-count` give `APP_MAX_COUNT`, one-character names have none).
+         *  Flags are set by `1`, `true`, `yes` or `on` and left unset by `0`, `false`, `no`, `off`.
+         *  The environment is scanned once by \ref parse(), the values go through the same conversion and validation,
+         *  and a variable overrides the \ref config_file() "configuration file", but not the arguments.
+         *
+         *  \param prefix Prefix of the variables (e.g. `APP_`).
+         *  \return Reference to itself.
+         */
+        clipper& env_prefix(std::string_view prefix) {
+            _env_prefix = prefix;
+            _layers_ready = false;
+            return *this;
+        }
+
+        /**
+         *  \brief Takes the values of options that are given neither in the arguments nor in the environment from a file.
+         *
+         *  Every line is `name = value` with the option name without the leading dashes, values can be in double quotes.
+         *  Empty lines, `#` and `;` comments (also after unquoted values) and `[section]` headers are skipped.
+         *  Flags take the same values as in \ref env_prefix(). The file is read by \ref parse() in one pass:
+         *  it is memory-mapped and the values are views into it (std::string_view options refer to it until the next parse).
+         *  A missing file is not an error, unknown names and lines without `=` are (\ref error_kind::config_file).
+         *
+         *  \param path Path of the file.
+         *  \return Reference to itself.
+         */
+        clipper& config_file(std::string_view path) {
+            _config_path = path;
+            return *this;
+        }
+
+        /**
+         *  \brief Checks if no arguments were given.
+         *  \return True if no arguments were given (always true before parsing), false if any arguments were given.
+         *  \see allow_no_args() parse()
+         */
+        inline bool no_args() const {
+            return _args_count == 1;
+        }
+
+        /**
+         *  \brief Clears the state of the last parse, so that the instance can be reused.
+         *
+         *  Errors are discarded, options are marked as not set and the bound variables
+         *  get their default values back. Capacity of the internal containers is kept,
+         *  so a reused instance does not allocate for the same kind of input.
+         *
+         *  \see parse()
+         */
+        inline void reset() {
+            for (option_base* opt : _options)
+                opt->reset();
+
+            for (auto& cmd : _commands)
+                if (nullptr != cmd.instance)
+                    cmd.instance->reset();
+            _selected = nullptr;
+            _passthrough = { };
+
+            if (_help_flag.is_used())
+                _help_flag.hndl->reset();
+
+            if (_version_flag.is_used())
+                _version_flag.hndl->reset();
+
+            _given.clear();
+            _errors.clear();
+            _wrong.clear();
+            _args_count = { };
+            _args = { };
+        }
+
+#if CLIPPER_INSTRUMENT
+        /**
+         *  \brief Sets the observer of parsing (only with \ref CLIPPER_INSTRUMENT defined as 1).
+         *
+         *  The observer is told about the looked up arguments, the converted values and the durations
+         *  of the parsing phases, \ref parse_stats collects them. Subcommands get the observer when they are first selected.
+         *
+         *  \param observer Observer (has to outlive the instance), nullptr for none.
+         *  \return Reference to itself.
+         */
+        clipper& observe(parse_observer* observer) noexcept {
+            _observer = observer;
+            return *this;
+        }
+#endif
+
+        /**
+         *  \brief Answers a shell completion request (the hidden `__complete` mode).
+         *
+         *  If the first argument is `__complete`, the ones after it are the words typed so far
+         *  (the last one is the word being completed), and the candidates are written to the output, one per line.
+         *  Call it right after the options are declared and exit if it returns true,
+         *  the scripts of \ref completion_script() run the application this way on every TAB press.
+         *
+         *  \code
+         *  if (cli.complete(argc, argv))
+         *      return 0;
+         *  \endcode
+         *
+         *  \param argc Argument count.
+         *  \param argv Arguments.
+         *  \param out Output of the candidates.
+         *  \return True if it was a completion request, false otherwise (nothing is done).
+         *  \see complete(std::span<const char* const>, F&&) completion_script()
+         */
+        inline bool complete(arg_count argc, argv_ptr argv, std::FILE* out = stdout) {
+            if (argc < 2 or std::string_view(argv[1]) != "__complete")
+                return false;
+
+            std::pmr::string text(_resource);
+            complete({ argv + 2, static_cast<std::size_t>(argc - 2) }, [&text](std::string_view word) {
+                text.append(word).push_back('\n');
+            });
+            std::fwrite(text.data(), 1, text.size(), out);
+            return true;
+        }
+
+        /**
+         *  \brief Finds completion candidates of a word.
+         *
+         *  The candidates are the values allowed by \ref option::match() after an option (also in the `--name=` form),
+         *  and the option and command names otherwise. The words before the completed one select
+         *  the subcommand and tell whether a value is expected. The candidates are looked up in a prefix trie.
+         *
+         *  \param words Words typed so far (without the application name), the completed one last.
+         *  \param emit Function called with every candidate (std::string_view, valid only during the call).
+         */
+        template<typename F>
+        void complete(std::span<const char* const> words, F&& emit) {
+            std::pmr::monotonic_buffer_resource buffer(_resource);
+            std::pmr::vector<std::string_view> candidates(&buffer);
+            std::string_view word = words.empty() ? std::string_view() : words.back();
+
+            clipper* cli = this;
+            std::size_t pending = detail::npos; // option waiting for its value
+            for (std::size_t i = 0; i + 1 < words.size(); i++) {
+                std::string_view arg = words[i];
+                if (detail::npos != pending) {
+                    pending = detail::npos;
+                    continue;
+                }
+                if (arg == "--")
+                    return; // passthrough arguments
+
+                std::size_t slot = cli->find_option(arg);
+                if (detail::npos != slot) {
+                    if (cli->_options[slot]->type() == otype::option)
+                        pending = slot;
+                }
+                else if (std::size_t cmd = cli->find_command(arg); detail::npos != cmd) {
+                    cli = &cli->select_command(cmd);
+                }
+            }
+
+            std::pmr::vector<std::pmr::string> values(&buffer);
+            detail::completion_trie trie(&buffer);
+            std::size_t eq = detail::npos;
+            if (detail::npos == pending and detail::npos != (eq = cli->find_attached(word)))
+                pending = cli->find_option(word.substr(0, eq));
+
+            if (detail::npos != pending) {
+                cli->_options[pending]->allowed_values(values);
+                candidates.assign(values.begin(), values.end());
+                trie.build(candidates);
+
+                if (detail::npos == eq) {
+                    trie.find(word, emit);
+                }
+                else {
+                    std::pmr::string attached(word.substr(0, eq + 1), &buffer);
+                    trie.find(word.substr(eq + 1), [&](std::string_view value) {
+                        attached.resize(eq + 1);
+                        emit(std::string_view(attached.append(value)));
+                    });
+                }
+                return;
+            }
+
+            cli->names(candidates);
+            trie.build(candidates);
+            trie.find(word, emit);
+        }
+
+        /**
+         *  \brief Creates a completion script for a shell.
+         *
+         *  The script completes the arguments of the application by running it in the `__complete` mode
+         *  (see \ref complete()), and falls back to file names when there are no candidates.
+         *  Source it, or put it where the shell looks for completions, e.g.\ `app --completion bash > /etc/bash_completion.d/app`.
+         *
+         *  \param sh Shell.
+         *  \return Script contents.
+         */
+        inline std::string completion_script(shell sh) const {
+            std::string fn(_app_name);
+            for (char& c : fn)
+                if (not std::isalnum(static_cast<unsigned char>(c)))
+                    c = '_';
+            const std::string app(_app_name);
+
+            switch (sh) {
+            case shell::bash:
+                return
+                    "_" + fn + "_complete() {\n"
+                    "    local IFS=$'\\n'\n"
+                    "    COMPREPLY=( $(" + app + " __complete \"${COMP_WORDS[@]:1:COMP_CWORD}\" 2>/dev/null) )\n"
+                    "}\n"
+                    "complete -o default -F _" + fn + "_complete " + app + "\n";
+            case shell::zsh:
+                return
+                    "#compdef " + app + "\n"
+                    "_" + fn + "() {\n"
+                    "    local -a candidates\n"
+                    "    candidates=(${(f)\"$(" + app + " __complete \"${(@)words[2,CURRENT]}\" 2>/dev/null)\"})\n"
+                    "    if (( ${#candidates} )); then\n"
+                    "        compadd -a candidates\n"
+                    "    else\n"
+                    "        _files\n"
+                    "    fi\n"
+                    "}\n"
+                    "compdef _" + fn + " " + app + "\n";
+            case shell::fish:
+                return
+                    "complete -c " + app + " -a '(" + app + " __complete (commandline -opc)[2..-1] (commandline -ct) 2>/dev/null)'\n";
+            }
+            return { };
+        }
+
+        /**
+         *  \brief Parses the command line input.
+         *
+         *  Errors of the previous call are discarded, values given previously are kept
+         *  (use \ref reset() to restore the defaults between calls).
+         *
+         *  \param argc Argument count.
+         *  \param argv Arguments.
+         *  \return True if arguments were parsed successfully, false otherwise.
+         */
+        inline bool parse(arg_count argc, argv_ptr argv) {
+            const auto size = static_cast<std::size_t>(argc);
+            return parse_args({ argv, nullptr, size }, { argv, size, false, detail::npos }, _response_files);
+        }
+
+        /**
+         *  \brief Parses the command line input into a separate result.
+         *
+         *  Nothing in the clipper instance (or the bound variables) is modified,
+         *  so many threads can parse against the same instance at once,
+         *  as long as no options are added meanwhile. Call \ref compile() first,
+         *  to have all the checks done with the precomputed sets.
+         *
+         *  \param argc Argument count.
+         *  \param argv Arguments (have to outlive the result).
+         *  \param[out] result Parsing result (its memory is reused).
+         *  \return True if arguments were parsed successfully, false otherwise.
+         *  \see parse_result compile()
+         */
+        inline bool parse(arg_count argc, argv_ptr argv, parse_result& result) const {
+            result.clear();
+            result._schema = this;
+            result._args = { argv, nullptr, static_cast<std::size_t>(argc) };
+            result._argc = argc;
+            result._given.resize(_options.size());
+            result._values.resize(_options.size());
+
+            if (argc < 2) {
+                result._ok = _allow_no_args;
+                return result._ok;
+            }
+            else if (argc == 2 and (_help_flag == argv[1] or _version_flag == argv[1])) {
+                result._help = _help_flag == argv[1];
+                result._version = not result._help;
+                result._ok = true;
+                return true;
+            }
+
+            if (_response_files) {
+                phase_timer timer(this, parse_phase::expand);
+                result._args = result._response.expand(result._args.size, argv, result._errors);
+            }
+
+            std::size_t end;
+            {
+                phase_timer timer(this, parse_phase::scan);
+                end = scan(result._args, result._given, result._errors, [this, &result](option_base& opt, token t, std::size_t slot) {
+                    result._values[slot] = t.value;
+                    if (result._lazy)
+                        return assign_status::ok;
+
+                    assign_status status = check_option(opt, t.value);
+                    observe_conversion(opt, status);
+                    return status;
+                });
+            }
+
+            // subcommands are not dispatched here
+            argv_source src { argv, static_cast<std::size_t>(argc), nullptr != result._args.views, result._response.tail() };
+            if (end != result._args.size and (result._args[end] != "--" or not find_passthrough(result._args, end, src, result._passthrough)))
+                add_error(result._errors, error_kind::unknown_argument, end);
+
+            {
+                phase_timer timer(this, parse_phase::check);
+                check_constraints(result._given, result._errors);
+            }
+            result._ok = result._errors.empty();
+            return result._ok;
+        }
+
+        /**
+         *  \brief Parses many command lines, one per line of a buffer.
+         *
+         *  Lines hold the arguments without the program name, split like response files
+         *  (whitespace, shell-like quotes and backslash escapes), `@file` arguments are not expanded.
+         *  The lines are parsed by a number of threads and nothing in the clipper instance is modified,
+         *  call \ref compile() first.
+         *
+         *  \param lines Newline-separated command lines (copied into the result).
+         *  \param[out] result Parsing result (its memory is reused).
+         *  \param threads Number of threads (0 for the hardware concurrency).
+         *  \return True if all the lines were parsed successfully, false otherwise.
+         *  \see batch_result parse_batch_file()
+         */
+        inline bool parse_batch(std::string_view lines, batch_result& result, unsigned threads = 0) const {
+            result.clear();
+            result._buffer.assign(lines.begin(), lines.end());
+            return parse_lines(result._buffer.data(), result._buffer.size(), result, threads);
+        }
+
+        /**
+         *  \brief Parses many command lines, one per line of a file.
+         *
+         *  The file is memory-mapped (privately) and the lines are split in place.
+         *
+         *  \param path Path of the file.
+         *  \param[out] result Parsing result (its memory is reused).
+         *  \param threads Number of threads (0 for the hardware concurrency).
+         *  \return True if all the lines were parsed successfully, false otherwise (also if the file cannot be read).
+         *  \see parse_batch()
+         */
+        inline bool parse_batch_file(const char* path, batch_result& result, unsigned threads = 0) const {
+            result.clear();
+            if (not result._file.open(path))
+                return false;
+            return parse_lines(result._file.data(), result._file.size(), result, threads);
+        }
+
+        /**
+         *  \brief Prepares the instance for parsing (done automatically by \ref parse(arg_count, argv_ptr)).
+         *
+         *  Call it after all the options are added, before sharing the instance between threads.
+         *
+         *  \return Constant reference to itself (the compiled schema).
+         *  \see parse(arg_count, argv_ptr, parse_result&) const
+         */
+        inline const clipper& compile() {
+            prepare();
+            return *this;
+        }
+
+        /**
+         *  \brief Gets a list of parsing errors.
+         *
+         *  The messages are created on the first call after parsing,
+         *  the arguments given to \ref parse() have to be still valid.
+         *  If a \ref command() "subcommand" was selected, these are its errors.
+         *
+         *  \return Reference to a vector that contains all parsing errors.
+         *  \see errors() format_error()
+         */
+        const std::pmr::vector<std::pmr::string>& wrong() const {
+            if (nullptr != _selected)
+                return _selected->wrong();
+
+            if (_wrong.size() != _errors.size()) {
+                _wrong.clear();
+                for (const auto& err : _errors)
+                    _wrong.emplace_back(format_error(err));
+            }
+            return _wrong;
+        }
+
+        /**
+         *  \brief Gets a list of parsing errors (not formatted).
+         *  \return Reference to a vector that contains all parsing errors.
+         *  \see parse_error format_error() wrong()
+         */
+        const std::pmr::vector<parse_error>& errors() const noexcept
+        { return nullptr != _selected ? _selected->errors() : _errors; }
+
+        /**
+         *  \brief Creates a message describing a parsing error.
+         *
+         *  The arguments given to the \ref parse() call that caused the error have to be still valid.
+         *
+         *  \param err Error of the last parse.
+         *  \return Error message.
+         *  \see errors() wrong()
+         */
+        std::string format_error(const parse_error& err) const
+        { return nullptr != _selected ? _selected->format_error(err) : format_error(err, _args); }
+
+    private:
+        /**
+         *  \internal
+         *  \brief Creates a message describing a parsing error.
+         *  \param err Parsing error.
+         *  \param args Arguments that caused the error.
+         */
+        std::string format_error(const parse_error& err, detail::arg_list args) const {
+            switch (err.kind) {
+            case error_kind::unknown_argument: {
+                std::string msg = std::string("[").append(args[err.index]).append("] Unkonown argument");
+                suggest_name(msg, args[err.index]);
+                return msg;
+            }
+            case error_kind::missing_value:
+                return std::string("[").append(args[err.index]).append("] Missing option value");
+            case error_kind::invalid_value:
+            case error_kind::not_allowed: {
+                const option_base* opt = _options[err.slot];
+                std::string_view arg = args[err.index], name = arg, value;
+                char cluster_name[2] { '-' };
+                if (is_positional(err.slot)) {
+                    name = opt->name;
+                    value = arg;
+                }
+                else if (find_option(arg) != detail::npos) {
+                    value = args[err.index + 1];
+                }
+                else if (std::size_t eq = find_attached(arg); eq != detail::npos) {
+                    value = arg.substr(eq + 1);
+                    name = arg.substr(0, eq);
+                }
+                else if (std::size_t end = find_cluster(arg); end != detail::npos) {
+                    value = end < arg.size() ? arg.substr(end) : args[err.index + 1];
+                    cluster_name[1] = arg[end - 1];
+                    name = std::string_view(cluster_name, 2);
+                }
+
+                return value_message(name, value, err.slot);
+            }
+            case error_kind::response_file:
+                return std::string("[").append(args[err.index]).append("] Cannot read the response file");
+            case error_kind::environment:
+                return value_message(_layer_keys[err.slot], _layer_values[err.slot], err.slot);
+            case error_kind::config_file: {
+                std::string place = std::string(_config_path).append(":").append(std::to_string(err.index));
+                if (err.slot != parse_error::none)
+                    return value_message(place.append(" ").append(_layer_keys[err.slot]), _layer_values[err.slot], err.slot);
+
+                config_entry entry = config_line(err.index);
+                if (entry.kind == config_entry::invalid)
+                    return "[" + place + "] Expected name = value";
+                return "[" + place + "] Unkonown option " + std::string(entry.name);
+            }
+            case error_kind::missing_required:
+                return "[" + std::string(_options[err.slot]->alt_name) + "] Missing required argument";
+            case error_kind::exclusive:
+                return "[" + group_names(_groups[err.slot]) + "] Options are mutually exclusive";
+            case error_kind::one_of:
+                return "[" + group_names(_groups[err.slot]) + "] One of the options is required";
+            case error_kind::all_of:
+                return "[" + group_names(_groups[err.slot]) + "] Options have to be used together";
+            }
+            return { };
+        }
+
+        /**
+         *  \internal
+         *  \brief Measures a parsing phase and reports it to the observer (does nothing without \ref CLIPPER_INSTRUMENT).
+         */
+        struct phase_timer {
+#if CLIPPER_INSTRUMENT
+            phase_timer(const clipper* cli, parse_phase ph) noexcept
+                : observer(cli->_observer), phase(ph) {
+                if (nullptr != observer)
+                    start = std::chrono::steady_clock::now();
+            }
+
+            ~phase_timer() {
+                if (nullptr != observer)
+                    observer->phase(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+            }
+
+            parse_observer* observer; ///< Observer (nullptr if there is none).
+            parse_phase phase; ///< Measured phase.
+            std::chrono::steady_clock::time_point start { }; ///< Start of the phase.
+#else
+            constexpr phase_timer(const clipper*, parse_phase) noexcept {}
+#endif
+            phase_timer(const phase_timer&) = delete;
+            phase_timer& operator=(const phase_timer&) = delete;
+        };
+
+        /// \internal
+        /// \brief Reports a lookup to the observer (does nothing without \ref CLIPPER_INSTRUMENT).
+        inline void observe_lookup(std::string_view name, std::size_t slot) const {
+#if CLIPPER_INSTRUMENT
+            if (nullptr != _observer)
+                _observer->lookup(name, detail::npos != slot);
+#else
+            (void)name;
+            (void)slot;
+#endif
+        }
+
+        /// \internal
+        /// \brief Reports a conversion to the observer (does nothing without \ref CLIPPER_INSTRUMENT).
+        inline void observe_conversion(const option_base& opt, assign_status status) const {
+#if CLIPPER_INSTRUMENT
+            if (nullptr != _observer)
+                _observer->conversion(opt.name, status);
+#else
+            (void)opt;
+            (void)status;
+#endif
+        }
+
+        /**
+         *  \internal
+         *  \brief Creates the message of a value that is not allowed (with the closest allowed values).
+         *  \param name Where the value was given (argument or source).
+         *  \param value Value.
+         *  \param slot Option slot.
+         */
+        std::string value_message(std::string_view name, std::string_view value, std::size_t slot) const {
+            const option_base* opt = _options[slot];
+            std::string msg = std::string("[").append(name).append("] Value ").append(value)
+                .append(" is not allowed \n\t{ ").append(is_positional(slot) ? opt->value_info() : opt->detailed_synopsis()).append("  ").append(opt->doc()).append(" }");
+
+            std::pmr::monotonic_buffer_resource buffer(_resource);
+            std::pmr::vector<std::pmr::string> allowed(&buffer);
+            opt->allowed_values(allowed);
+            if (not allowed.empty()) {
+                std::pmr::vector<std::string_view> candidates(allowed.begin(), allowed.end(), &buffer);
+                suggest(msg, value, candidates);
+            }
+            return msg;
+        }
+
+        /// \internal
+        /// \brief Line of a configuration file (\ref config_file()).
+        struct config_entry {
+            enum : unsigned char { blank, invalid, entry } kind; ///< Kind of the line (blank ones are empty, comments and section headers).
+            std::string_view name, value; ///< Option name and the value.
+        };
+
+        /// \internal
+        /// \brief Splits a line of a configuration file.
+        static config_entry parse_config_line(std::string_view line) noexcept {
+            auto trim = [](std::string_view str) {
+                const std::size_t first = str.find_first_not_of(" \t\r");
+                if (first == std::string_view::npos)
+                    return std::string_view();
+                return str.substr(first, str.find_last_not_of(" \t\r") - first + 1);
+            };
+
+            line = trim(line);
+            if (line.empty() or line.front() == '#' or line.front() == ';' or line.front() == '[')
+                return { config_entry::blank, { }, { } };
+
+            const std::size_t eq = line.find('=');
+            if (eq == std::string_view::npos)
+                return { config_entry::invalid, { }, { } };
+
+            std::string_view name = trim(line.substr(0, eq)), value = trim(line.substr(eq + 1));
+            while (name.starts_with('-'))
+                name.remove_prefix(1);
+
+            if (value.size() >= 2 and value.front() == '"') {
+                if (std::size_t end = value.find('"', 1); end != std::string_view::npos)
+                    value = value.substr(1, end - 1);
+            }
+            else if (std::size_t comment = value.find_first_of("#;"); comment != std::string_view::npos) {
+                value = trim(value.substr(0, comment));
+            }
+            return { config_entry::entry, name, value };
+        }
+
+        /// \internal
+        /// \brief Finds a line of the loaded configuration file (for the error messages).
+        config_entry config_line(std::size_t number) const noexcept {
+            std::string_view text(_config.data(), _config.size());
+            for (std::size_t n = 1; n < number and not text.empty(); n++) {
+                std::size_t nl = text.find('\n');
+                text.remove_prefix(nl == std::string_view::npos ? text.size() : nl + 1);
+            }
+            return parse_config_line(text.substr(0, text.find('\n')));
+        }
+
+        /**
+         *  \internal
+         *  \brief Builds the names used in the environment and the configuration file.
+         *
+         *  The variable names are written into one buffer first, so the views of the index do not move.
+         */
+        inline void index_layers() {
+            _env_names.clear();
+            _config_names.clear();
+            _env_keys.clear();
+
+            auto env_name = [this](std::string_view name) {
+                _env_keys.append(_env_prefix);
+                for (char c : name.substr(name.find_first_not_of('-')))
+                    _env_keys.push_back(c == '-' or c == '.' ? '_' : static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+            };
+
+            std::pmr::vector<std::pair<std::size_t, std::size_t>> ranges(_resource);
+            std::pmr::vector<std::size_t> slots(_resource);
+            for (std::size_t slot = 0; slot < _options.size(); slot++) {
+                if (is_positional(slot))
+                    continue;
+
+                for (std::string_view name : { _options[slot]->name, _options[slot]->alt_name }) {
+                    if (name.empty() or is_short_name(name) or name.find_first_not_of('-') == std::string_view::npos)
+                        continue;
+
+                    _config_names.emplace(name.substr(name.find_first_not_of('-')), slot);
+                    if (not _env_prefix.empty()) {
+                        std::size_t start = _env_keys.size();
+                        env_name(name);
+                        ranges.emplace_back(start, _env_keys.size() - start);
+                        slots.push_back(slot);
+                    }
+                }
+            }
+
+            for (std::size_t i = 0; i < ranges.size(); i++)
+                _env_names.emplace(std::string_view(_env_keys).substr(ranges[i].first, ranges[i].second), slots[i]);
+            _layers_ready = true;
+        }
+
+        /**
+         *  \internal
+         *  \brief Assigns the values of the environment and of the configuration file to the options that were not given.
+         *
+         *  Both sources are read in one pass each, the file first, so the environment overrides it.
+         */
+        inline void apply_layers(detail::slot_set& given, std::pmr::vector<parse_error>& errors) {
+            if (not _layers_ready)
+                index_layers();
+
+            _layer_values.assign(_options.size(), { });
+            _layer_keys.assign(_options.size(), { });
+            _layer_lines.assign(_options.size(), parse_error::none);
+
+            if (not _config_path.empty() and _config.open(_config_path.c_str())) {
+                std::string_view text(_config.data(), _config.size());
+                for (std::uint32_t line = 1; not text.empty(); line++) {
+                    const std::size_t nl = text.find('\n');
+                    const config_entry entry = parse_config_line(text.substr(0, nl));
+                    text.remove_prefix(nl == std::string_view::npos ? text.size() : nl + 1);
+
+                    if (entry.kind == config_entry::blank)
+                        continue;
+
+                    auto it = entry.kind == config_entry::entry ? _config_names.find(entry.name) : _config_names.end();
+                    if (it == _config_names.end()) {
+                        add_error(errors, error_kind::config_file, line);
+                        continue;
+                    }
+                    _layer_values[it->second] = entry.value;
+                    _layer_keys[it->second] = entry.name;
+                    _layer_lines[it->second] = line;
+                }
+            }
+
+            if (not _env_prefix.empty()) {
+                for (char** env = detail::environment(); nullptr != env and nullptr != *env; env++) {
+                    std::string_view var(*env);
+                    if (not var.starts_with(_env_prefix))
+                        continue;
+
+                    const std::size_t eq = var.find('=');
+                    auto it = eq == std::string_view::npos ? _env_names.end() : _env_names.find(var.substr(0, eq));
+                    if (it == _env_names.end())
+                        continue;
+
+                    _layer_values[it->second] = var.substr(eq + 1);
+                    _layer_keys[it->second] = var.substr(0, eq);
+                    _layer_lines[it->second] = parse_error::none;
+                }
+            }
+
+            for (std::size_t slot = 0; slot < _options.size(); slot++) {
+                if (given.test(slot) or nullptr == _layer_values[slot].data())
+                    continue;
+
+                option_base& opt = *_options[slot];
+                std::string_view value = _layer_values[slot];
+                assign_status status = assign_status::ok;
+                if (opt.type() == otype::flag) {
+                    if (value == "1" or value == "true" or value == "yes" or value == "on")
+                        status = assign_option(opt, value);
+                    else if (value == "0" or value == "false" or value == "no" or value == "off")
+                        continue; // left unset
+                    else
+                        status = assign_status::invalid_value;
+                }
+                else {
+                    status = assign_option(opt, value);
+                }
+
+                observe_conversion(opt, status);
+                given.set(slot);
+                if (status != assign_status::ok) {
+                    if (parse_error::none == _layer_lines[slot])
+                        add_error(errors, error_kind::environment, parse_error::none, slot);
+                    else
+                        add_error(errors, error_kind::config_file, _layer_lines[slot], slot);
+                }
+            }
+        }
+
+        /**
+         *  \internal
+         *  \brief Appends the candidates closest to a word to a message (` (did you mean ...?)`), if any is close enough.
+         *
+         *  The allowed distance is a third of the word length (at least one edit), only the closest candidates
+         *  are kept (at most \ref max_suggestions), and the word itself is never suggested.
+         */
+        static void suggest(std::string& msg, std::string_view word, std::span<const std::string_view> candidates) {
+            if (word.empty())
+                return;
+
+            const detail::edit_distance distance(word);
+            std::size_t bound = std::max<std::size_t>(1, word.size() / 3);
+            std::array<std::string_view, max_suggestions> best;
+            std::size_t count = 0;
+
+            for (std::string_view candidate : candidates) {
+                if (candidate == word)
+                    continue;
+
+                std::size_t d = distance(candidate, bound);
+                if (d > bound)
+                    continue;
+                if (d < bound) { // closer than all of the previous ones
+                    bound = d;
+                    count = 0;
+                }
+                if (count < best.size() and std::find(best.begin(), best.begin() + count, candidate) == best.begin() + count)
+                    best[count++] = candidate;
+            }
+
+            if (0 == count)
+                return;
+
+            msg.append(" (did you mean ");
+            for (std::size_t i = 0; i < count; i++) {
+                if (i > 0)
+                    msg.append(i + 1 == count ? " or " : ", ");
+                msg.append(best[i]);
+            }
+            msg.append("?)");
         }
 
         /**
-         *  \brief  Sets/activates the help/version \ref option< bool > "flag (option<bool>)".
-         * 
-         *  Help/Version flag is not a standard flag, it has to be used independently.
-         *  When used with other options is treated as an unknown option.
-         * 
-         *  \param  name Primary flag name.
-         *  \param  alt_name Secondary flag name. (optional)
-         *  \return Help/Version flag reference.
-         *  \see    option<bool>
+         *  \internal
+         *  \brief Suggests option and command names for an unknown argument (the name part of `--name=value`).
+         *
+         *  One-character names are left out, every other one is a single edit away from them.
          */
-        option<bool>& help_flag(std::string_view name, std::string_view alt_name = "") {
-            _help_flag.hndl = std::make_unique<option<bool>>(name, alt_name);
-            _help_flag.hndl->doc("Displays help");
-            return *_help_flag.hndl;
-        }
-        
-        /// \copydoc help_flag
-        option<bool>& version_flag(std::string_view name, std::string_view alt_name = "") {
-            _version_flag.hndl = std::make_unique<option<bool>>(name, alt_name);
-            _version_flag.hndl->doc("Displays version information");
-            return *_version_flag.hndl;
+        void suggest_name(std::string& msg, std::string_view arg) const {
+            if (std::size_t eq = arg.find('='); eq != std::string_view::npos and eq > 0 and arg.front() == '-')
+                arg = arg.substr(0, eq);
+            if (arg.size() <= 2)
+                return;
+
+            std::pmr::monotonic_buffer_resource buffer(_resource);
+            std::pmr::vector<std::string_view> candidates(&buffer);
+            names(candidates);
+            std::erase_if(candidates, [](std::string_view name) { return name.size() <= 2; });
+            suggest(msg, arg, candidates);
         }
 
         /**
-         *  \brief  Creates a documentation (man page, help) for the application.
-         *  \return Documentation.
+         *  \internal
+         *  \brief Collects the names of the options, the help and version flags and of the commands.
          */
-        inline std::string make_help() const noexcept {
-            auto add_help = [](const option_base* const opt, std::ostringstream& stream) {
-                auto snps = opt->detailed_synopsis();
-
-                if (CLIPPER_HELP_ARG_FIELD_WIDTH <= snps.length()) {
-                    stream << '\t' << snps << "\n\t" << std::string(CLIPPER_HELP_ARG_FIELD_WIDTH, ' ') << opt->doc() << '\n';
-                }
-                else
-                    stream << '\t' << std::left << std::setw(CLIPPER_HELP_ARG_FIELD_WIDTH) << snps << opt->doc() << '\n';
+        void names(std::pmr::vector<std::string_view>& out) const {
+            auto add = [&out](const option_base& opt) {
+                out.push_back(opt.name);
+                if (opt.alt_name != opt.name and not opt.alt_name.empty())
+                    out.push_back(opt.alt_name);
             };
 
-            std::ostringstream flags;
-            std::ostringstream options;
-            
+            out.reserve(out.size() + 2 * _options.size() + _commands.size() + 4);
             if (_help_flag.is_used())
-                add_help(_help_flag.hndl.get(), flags);
-
+                add(*_help_flag.hndl);
             if (_version_flag.is_used())
-                add_help(_version_flag.hndl.get(), flags);
+                add(*_version_flag.hndl);
+            for (std::size_t slot = 0; slot < _options.size(); slot++)
+                if (not is_positional(slot))
+                    add(*_options[slot]);
+            for (const command_entry& cmd : _commands)
+                out.push_back(cmd.name);
+        }
 
-            for (auto& opt : _options) {
-                if (dynamic_cast<option<bool>*>(opt.get()))
-                    add_help(opt.get(), flags);
-                else
-                    add_help(opt.get(), options);
+        /**
+         *  \internal
+         *  \brief Resolves the arguments to options and passes them (with their values) on.
+         *  \param args Arguments.
+         *  \param[out] given Slots of the given options.
+         *  \param[out] errors Parsing errors.
+         *  \param set Function that sets (or checks) an option (option, token, slot), returns \ref assign_status.
+         *  \return Index of the subcommand argument or `--`, where the scan stopped (the argument count if there is none).
+         */
+        template<typename F>
+        inline std::size_t scan(detail::arg_list args, detail::slot_set& given, std::pmr::vector<parse_error>& errors, F set) const {
+            std::size_t positional = 0;
+
+            for (std::size_t i = 1; i < args.size; i++) {
+                std::string_view arg = args[i];
+                std::size_t slot = find_option(arg);
+                std::size_t eq = detail::npos;
+                observe_lookup(arg, slot);
+
+                if (detail::npos == slot) {
+                    if (arg == "--")
+                        return i;
+
+                    eq = find_attached(arg);
+                    if (detail::npos != eq) {
+                        slot = find_option(arg.substr(0, eq));
+                    }
+                    else if (std::size_t end = find_cluster(arg); detail::npos != end) {
+                        i = scan_cluster(args, i, end, given, errors, set);
+                        continue;
+                    }
+                    else if (not _commands.empty() and detail::npos != find_command(arg)) {
+                        return i;
+                    }
+                    else if (positional < _positionals.size() and not looks_like_option(arg)) {
+                        slot = _positionals[positional++];
+                        given.set(slot);
+                        assign_status status = set(*_options[slot], token { arg, arg }, slot);
+
+                        if (status != assign_status::ok)
+                            add_error(errors, status == assign_status::invalid_value ? error_kind::invalid_value : error_kind::not_allowed, i, slot);
+                        continue;
+                    }
+                    else {
+                        add_error(errors, error_kind::unknown_argument, i);
+                        continue;
+                    }
+                }
+
+                option_base* opt = _options[slot];
+                const std::size_t opt_index = i;
+
+                token t { arg, { } };
+                if (eq != detail::npos) {
+                    t.option = arg.substr(0, eq);
+                    t.value = arg.substr(eq + 1);
+                }
+                else if (opt->type() == otype::option) {
+                    if (++i < args.size) {
+                        t.value = args[i];
+                    }
+                    else {
+                        add_error(errors, error_kind::missing_value, opt_index, slot);
+                        break;
+                    }
+                }
+
+                given.set(slot);
+                assign_status status = set(*opt, t, slot);
+
+                if (status != assign_status::ok)
+                    add_error(errors, status == assign_status::invalid_value ? error_kind::invalid_value : error_kind::not_allowed, opt_index, slot);
             }
+            return args.size;
+        }
 
-            std::ostringstream help;
+        /**
+         *  \internal
+         *  \brief Parses the arguments into the bound variables (\ref parse(arg_count, argv_ptr)).
+         *  \param args Arguments (the first one is the program or command name).
+         *  \param src Arguments given to parse (that the passthrough arguments refer to).
+         *  \param expand Determines whether the response files are expanded (only the top level arguments are).
+         */
+        inline bool parse_args(detail::arg_list args, argv_source src, bool expand) {
+            _args_count = static_cast<arg_count>(args.size);
+            _args = args;
+            _errors.clear();
+            _wrong.clear();
+            _selected = nullptr;
+            _passthrough = { };
+
+            const bool layers = not _env_prefix.empty() or not _config_path.empty();
+            if (args.size < 2) {
+                if (layers and _allow_no_args) { // the values still come from the environment and the file
+                    _given.clear();
+                    apply_layers(_given, _errors);
+                    return _errors.empty();
+                }
+                return _allow_no_args; // success if allowed, failure if not
+            }
+            else if (args.size == 2 && check_for_helper_flags(args[1])) // check if help or version flag was used (propery)
+                return true;
 
-            if (not _app_description.empty())
-                help << "DESCRIPTION\n\t" << description() << "\n\n";
-            
-            // SYNOPSIS
-            help << "SYNOPSIS\n\t" << _app_name;
 
-            for (auto& opt : _options)
-                if (opt->req())
-                    help << " " << opt->synopsis();
+            if (not _prepared)
+                prepare();
 
-            help << " [...]\n";
-            // end SYNOPSIS
+            _given.clear();
 
-            if (not flags.view().empty())
-                help << "\nFLAGS\n" << flags.view();
+            if (expand) {
+                phase_timer timer(this, parse_phase::expand);
+                _args = _response.expand(_args.size, args.argv, _errors);
+                src.expanded = nullptr != _args.views;
+                src.tail = _response.tail();
+            }
 
-            if (not options.view().empty())
-                help << "\nOPTIONS\n" << options.view();
+            std::size_t end;
+            {
+                phase_timer timer(this, parse_phase::scan);
+                end = scan(_args, _given, _errors, [this](option_base& opt, token t, std::size_t /* slot */) {
+                    assign_status status = assign_option(opt, t.value);
+                    observe_conversion(opt, status);
+                    return status;
+                });
+            }
 
-            if (not _license_notice.empty())
-                help << "\nLICENSE\n\t" << _license_notice << "\n";
+            if (end != _args.size and _args[end] == "--" and not find_passthrough(_args, end, src, _passthrough))
+                add_error(_errors, error_kind::unknown_argument, end);
 
-            if (not _author.empty())
-                help << "\nAUTHOR\n\t" << _author << "\n";
+            if (layers)
+                apply_layers(_given, _errors);
 
-            if (not _web_link.empty())
-                help << "\n" << _web_link << "\n";
+            {
+                phase_timer timer(this, parse_phase::check);
+                check_constraints(_given, _errors);
+            }
+            if (end == _args.size or _args[end] == "--" or not _errors.empty())
+                return _errors.empty();
 
-            return help.str();
+            // the rest belongs to the subcommand
+            clipper& cmd = select_command(find_command(_args[end]));
+            _selected = &cmd;
+            return cmd.parse_args({ nullptr == _args.argv ? nullptr : _args.argv + end, nullptr == _args.views ? nullptr : _args.views + end, _args.size - end }, src, false);
         }
 
         /**
-         *  \brief  Creates a version notice for the application.
-         *  \return Version notice.
+         *  \internal
+         *  \brief Finds the arguments after `--` in the arguments given to parse.
+         *  \param args Scanned arguments.
+         *  \param end Index of the `--`.
+         *  \param src Arguments given to parse.
+         *  \param[out] out Arguments after `--`.
+         *  \return False if the `--` comes from a response file (the arguments are not in argv).
          */
-        inline std::string make_version_info() const noexcept {
-            return
-                std::string(_app_name).append(" ")
-                .append(_version).append("\n")
-                .append(_author).append("\n");
+        static inline bool find_passthrough(detail::arg_list args, std::size_t end, argv_source src, std::span<const char* const>& out) noexcept {
+            const std::size_t count = args.size - end - 1;
+            if (src.expanded and src.tail != count)
+                return false;
+
+            out = { src.argv + (src.argc - count), count };
+            return true;
         }
 
-        /**
-         *  \brief Allows the app to be used without any arguments.
-         * 
-         *  This function allows for using the app without any arguments (even the ones marked as required).
-         *  When this function is used, there will be no parsing errors when no arguments are given.
-         *  
-         *  \see no_args() parse()
-         */
-        inline void allow_no_args() {
-            _allow_no_args = true;
+        /// \internal
+        /// \brief Finds an option or a positional argument by its name.
+        /// \return Option slot or \ref detail::npos if there is no such option.
+        inline std::size_t find_named(std::string_view name) const {
+            if (std::size_t slot = find_option(name); detail::npos != slot)
+                return slot;
+
+            for (std::uint32_t slot : _positionals)
+                if (_options[slot]->name == name)
+                    return slot;
+            return detail::npos;
         }
 
-        /**
-         *  \brief Checks if no arguments were given.
-         *  \return True if no arguments were given (always true before parsing), false if any arguments were given.
-         *  \see allow_no_args() parse()
-         */
-        inline bool no_args() const {
-            return _args_count == 1;
+        /// \internal
+        /// \brief Checks whether a slot belongs to a positional argument.
+        inline bool is_positional(std::size_t slot) const noexcept
+        { return std::find(_positionals.begin(), _positionals.end(), slot) != _positionals.end(); }
+
+        /// \internal
+        /// \brief Finds a subcommand by its name.
+        /// \return Index of the command or \ref detail::npos if there is no such command.
+        inline std::size_t find_command(std::string_view name) const noexcept {
+            for (std::size_t i = 0; i < _commands.size(); i++)
+                if (_commands[i].name == name)
+                    return i;
+            return detail::npos;
+        }
+
+        /// \internal
+        /// \brief Gets a subcommand instance (creates it and adds its options first).
+        inline clipper& select_command(std::size_t index) {
+            command_entry& cmd = _commands[index];
+            if (nullptr == cmd.instance) {
+                clipper& inst = _arena.create<clipper>(cmd.name, _resource);
+                inst._app_description = cmd.description;
+                inst._parent = this;
+                inst._help_flag = _help_flag;
+                inst._version_flag = _version_flag;
+#if CLIPPER_INSTRUMENT
+                inst._observer = _observer;
+#endif
+                cmd.setup(cmd.callable, inst);
+                cmd.instance = &inst;
+            }
+            return *cmd.instance;
         }
 
         /**
-         *  \brief Parses the command line input.
-         *  \param argc Argument count.
-         *  \param argv Arguments.
-         *  \return True if arguments were parsed successfully, false otherwise.
+         *  \internal
+         *  \brief Parses the lines of a buffer in place (\ref parse_batch()).
+         *
+         *  Threads take chunks of \ref batch_chunk lines from a shared counter, so a slow chunk
+         *  does not hold the others back. Each thread writes the values of its own lines straight
+         *  into the columns and keeps the failures, which are merged in line order at the end.
          */
-        inline bool parse(arg_count argc, argv_ptr argv) {
-            _args_count = argc;
-            
-            if (argc < 2)
-                return _allow_no_args; // success if allowed, failure if not
-            else if (argc == 2 && check_for_helper_flags(argv[1])) // check if help or version flag was used (propery)
-                return true;
-            
+        inline bool parse_lines(char* data, std::size_t size, batch_result& result, unsigned threads) const {
+            result._schema = this;
+
+            std::pmr::vector<std::size_t> begins(result._values.get_allocator());
+            for (std::size_t pos = 0; pos < size; ) {
+                begins.push_back(pos);
+                const void* nl = std::memchr(data + pos, '\n', size - pos);
+                pos = nullptr == nl ? size : static_cast<std::size_t>(static_cast<const char*>(nl) - data) + 1;
+            }
+            begins.push_back(size);
+
+            const std::size_t lines = begins.size() - 1;
+            const std::size_t slots = _options.size();
+            result._lines = lines;
+            result._values.assign(slots * lines, { });
+            result._given.assign(slots * lines, 0);
+
+            // thread local state allocates from the global heap (the resources need not be thread-safe)
+            struct worker {
+                std::vector<std::string_view> args;
+                detail::slot_set given { std::pmr::new_delete_resource() };
+                std::pmr::vector<parse_error> errors { std::pmr::new_delete_resource() };
+                std::vector<batch_result::failure> failures;
+                std::vector<parse_error> failure_errors;
+                std::vector<std::string_view> failure_args;
+            };
+
+            std::atomic<std::size_t> next { 0 };
+            auto run = [&](worker& w) {
+                w.given.resize(slots);
+
+                for (std::size_t first; (first = next.fetch_add(batch_chunk, std::memory_order_relaxed)) < lines; ) {
+                    for (std::size_t line = first, last = std::min(first + batch_chunk, lines); line < last; line++) {
+                        w.args.clear();
+                        w.args.push_back(_app_name);
+                        detail::tokenize(data + begins[line], data + begins[line + 1], [&w](std::string_view arg) {
+                            w.args.push_back(arg);
+                        });
+
+                        detail::arg_list args { nullptr, w.args.data(), w.args.size() };
+                        w.errors.clear();
+
+                        bool ok;
+                        if (args.size < 2) {
+                            ok = _allow_no_args;
+                        }
+                        else if (args.size == 2 and (args[1] == _help_flag or args[1] == _version_flag)) {
+                            ok = true;
+                        }
+                        else {
+                            w.given.clear();
+                            std::size_t end = scan(args, w.given, w.errors, [this, &result, lines, line](option_base& opt, token t, std::size_t slot) {
+                                result._values[slot * lines + line] = t.value;
+                                result._given[slot * lines + line] = 1;
+                                assign_status status = check_option(opt, t.value);
+                                observe_conversion(opt, status);
+                                return status;
+                            });
+                            if (end != args.size and args[end] != "--") // the arguments after -- are not checked
+                                add_error(w.errors, error_kind::unknown_argument, end);
+                            check_constraints(w.given, w.errors);
+                            ok = w.errors.empty();
+                        }
+
+                        if (not ok) {
+                            w.failures.push_back({ line, static_cast<std::uint32_t>(w.failure_errors.size()), static_cast<std::uint32_t>(w.errors.size()),
+                                                   static_cast<std::uint32_t>(w.failure_args.size()), static_cast<std::uint32_t>(args.size) });
+                            w.failure_errors.insert(w.failure_errors.end(), w.errors.begin(), w.errors.end());
+                            w.failure_args.insert(w.failure_args.end(), w.args.begin(), w.args.end());
+                        }
+                    }
+                }
+            };
 
-            auto req_count = count_req();
-            auto tokens = tokenize(argc, argv);
+            if (0 == threads)
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            threads = static_cast<unsigned>(std::min<std::size_t>(threads, (lines + batch_chunk - 1) / batch_chunk));
 
-            for (auto t : tokens) {
-                if (is_req_and_not_set(t.option))
-                    req_count--;
+            std::vector<worker> workers(std::max(1u, threads));
+            {
+                std::vector<std::thread> pool;
+                pool.reserve(workers.size() - 1);
+                for (std::size_t i = 1; i < workers.size(); i++)
+                    pool.emplace_back(run, std::ref(workers[i]));
+                run(workers[0]);
 
-                set_option(t);
+                for (auto& t : pool)
+                    t.join();
             }
 
-            if (req_count) {
-                _wrong.emplace_back("Missing required argument(s) " + std::to_string(req_count));
+            std::vector<std::pair<const batch_result::failure*, const worker*>> failures;
+            for (const auto& w : workers)
+                for (const auto& f : w.failures)
+                    failures.emplace_back(&f, &w);
+            std::sort(failures.begin(), failures.end(), [](const auto& l, const auto& r) { return l.first->line < r.first->line; });
+
+            for (auto [f, w] : failures) {
+                result._failed.push_back(f->line);
+                result._failures.push_back({ f->line, static_cast<std::uint32_t>(result._errors.size()), f->error_count,
+                                             static_cast<std::uint32_t>(result._args.size()), f->arg_count });
+                result._errors.insert(result._errors.end(), w->failure_errors.begin() + f->first_error, w->failure_errors.begin() + f->first_error + f->error_count);
+                result._args.insert(result._args.end(), w->failure_args.begin() + f->first_arg, w->failure_args.begin() + f->first_arg + f->arg_count);
             }
 
-            return _wrong.empty();
+            result._ok = result._failed.empty();
+            return result._ok;
         }
 
         /**
-         *  \brief Gets a list of parsing errors.
-         *  \return Reference to a vector that contains all parsing errors.
+         *  \internal
+         *  \brief Passes on the options of a cluster (\ref find_cluster()), as \ref scan() does.
+         *  \param i Index of the cluster argument.
+         *  \param end Position after the last option character of the cluster.
+         *  \return Index of the last argument used (the value of the last option may be the next argument).
          */
-        const std::vector<std::string>& wrong() const noexcept
-        { return _wrong; }
+        template<typename F>
+        inline std::size_t scan_cluster(detail::arg_list args, std::size_t i, std::size_t end, detail::slot_set& given, std::pmr::vector<parse_error>& errors, F& set) const {
+            const std::string_view arg = args[i];
+            const std::size_t opt_index = i;
+
+            for (std::size_t pos = 1; pos < end; pos++) {
+                const std::size_t slot = find_short(arg[pos]);
+                option_base* opt = _options[slot];
+
+                token t { arg, { } };
+                if (opt->type() == otype::option) {
+                    if (end < arg.size()) {
+                        t.value = arg.substr(end);
+                    }
+                    else if (++i < args.size) {
+                        t.value = args[i];
+                    }
+                    else {
+                        add_error(errors, error_kind::missing_value, opt_index, slot);
+                        break;
+                    }
+                }
+
+                given.set(slot);
+                assign_status status = set(*opt, t, slot);
+
+                if (status != assign_status::ok)
+                    add_error(errors, status == assign_status::invalid_value ? error_kind::invalid_value : error_kind::not_allowed, opt_index, slot);
+            }
+            return i;
+        }
+
+        /// \internal
+        /// \brief Assigns a value to an option (non-virtual call for the tagged types, virtual for the rest).
+        static inline assign_status assign_option(option_base& opt, std::string_view val) noexcept {
+            assign_status status = assign_status::ok;
+
+            bool tagged = detail::visit_tag(opt.tag(), [&]<typename T>() {
+                status = static_cast<option<T>&>(opt).option<T>::try_assign(val);
+            }, detail::tagged_types { });
+
+            return tagged ? status : opt.try_assign(val);
+        }
+
+        /// \internal
+        /// \brief Checks a value of an option (non-virtual call for the tagged types, virtual for the rest).
+        static inline assign_status check_option(const option_base& opt, std::string_view val) noexcept {
+            assign_status status = assign_status::ok;
+
+            bool tagged = detail::visit_tag(opt.tag(), [&]<typename T>() {
+                status = static_cast<const option<T>&>(opt).option<T>::check(val);
+            }, detail::tagged_types { });
+
+            return tagged ? status : opt.check(val);
+        }
+
+        /// \internal
+        /// \brief Records a parsing error.
+        static inline void add_error(std::pmr::vector<parse_error>& errors, error_kind kind, std::size_t index, std::size_t slot = parse_error::none) {
+            errors.push_back({ kind, static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(slot) });
+        }
+
+        /// \internal
+        /// \brief Builds the required options set (once, after the options are added).
+        inline void prepare() {
+            _required.clear();
+            for (std::size_t slot = 0; slot < _options.size(); slot++)
+                if (_options[slot]->req())
+                    _required.set(slot);
+
+            _prepared = true;
+        }
+
+        /// \internal
+        /// \brief Checks the required options and constraint groups against the given options.
+        inline void check_constraints(const detail::slot_set& given, std::pmr::vector<parse_error>& errors) const {
+            auto missing = [&](std::size_t slot) {
+                add_error(errors, error_kind::missing_required, parse_error::none, slot);
+            };
+
+            if (_prepared) {
+                _required.for_each_missing(given, missing);
+            }
+            else { // not compiled, can't update the required set in a const call
+                for (std::size_t slot = 0; slot < _options.size(); slot++)
+                    if (_options[slot]->req() and not given.test(slot))
+                        missing(slot);
+            }
+
+            for (std::size_t i = 0; i < _groups.size(); i++) {
+                const group& grp = _groups[i];
+                std::size_t count = grp.slots.count_common(given);
+
+                switch (grp.kind) {
+                case group_kind::exclusive:
+                    if (count > 1)
+                        add_error(errors, error_kind::exclusive, parse_error::none, i);
+                    break;
+                case group_kind::one_of:
+                    if (count == 0)
+                        add_error(errors, error_kind::one_of, parse_error::none, i);
+                    break;
+                case group_kind::all_of:
+                    if (count != 0 and not grp.slots.is_subset_of(given))
+                        add_error(errors, error_kind::all_of, parse_error::none, i);
+                    break;
+                }
+            }
+        }
+
+        /// \internal
+        /// \brief Lists the names of the options of a constraint group.
+        inline std::string group_names(const group& grp) const {
+            std::string names;
+            grp.slots.for_each([&](std::size_t slot) {
+                if (not names.empty())
+                    names.push_back(' ');
+                names.append(_options[slot]->name);
+            });
+            return names;
+        }
+
+        /// \internal
+        /// \brief Creates a constraint group from option names.
+        template<typename... Names>
+        inline clipper& add_group(group_kind kind, Names... names) {
+            static_assert(sizeof...(Names) >= 2, "A constraint group needs at least two options");
+            static_assert((std::is_convertible_v<Names, std::string_view> && ...), "Option names must be convertible to std::string_view");
+
+            group grp { kind, detail::slot_set(_resource) };
+            grp.slots.resize(_options.size());
+
+            for (std::string_view name : { std::string_view(names)... }) {
+                std::size_t slot = find_option(name);
+                if (detail::npos == slot)
+                    CLIPPER_THROW(std::logic_error("Constraint group refers to an unknown option"));
+                grp.slots.set(slot);
+            }
+
+            _groups.push_back(std::move(grp));
+            _prepared = false;
+            return *this;
+        }
+
+        /// \internal
+        /// \brief Appends the names of the parent commands and of this one, starting with the application name.
+        inline void append_command_path(std::pmr::string& out) const {
+            if (nullptr != _parent) {
+                _parent->append_command_path(out);
+                out.push_back(' ');
+            }
+            out.append(_app_name);
+        }
 
-    private:
         /**
          *  \internal
-         *  \brief Creates a array of option + value tokens.
-         *  \param argc Argument count.
-         *  \param argv Arguments.
-         *  \see token
-         */
-        inline std::vector<token> tokenize(arg_count argc, argv_ptr argv) {
-            using namespace std::string_literals;
-            std::vector<token> tokens;
-            tokens.reserve(argc);
-
-            for (arg_count i = 1; i < argc; i++) {
-                if (option_exists(argv[i])) {
-                    if (get_option(argv[i])->type() == otype::flag)
-                        tokens.emplace_back(argv[i]);
-                    else if (++i < argc)
-                        tokens.emplace_back(argv[i - 1], argv[i]);
-                    else
-                        _wrong.emplace_back("["s + argv[i - 1] + "] Missing option value");
+         *  \brief Renders the documentation in one pass, into a buffer of about the right size.
+         */
+        inline void render_help(std::pmr::string& help) const {
+            constexpr std::size_t width = CLIPPER_HELP_ARG_FIELD_WIDTH;
+            help.clear();
+
+            std::size_t size = 128 + _app_description.size() + _license_notice.size() + _author.size() + _web_link.size();
+            for (const option_base* opt : _options)
+                size += width + opt->name.size() + opt->alt_name.size() + opt->doc().size() + 16;
+            for (const auto& cmd : _commands)
+                size += width + cmd.name.size() + cmd.description.size() + 2;
+            help.reserve(size);
+
+            // entry: synopsis padded to the field width (or on its own line), documentation
+            auto entry = [&help](std::string_view synopsis, const option_base* opt, std::string_view doc) {
+                std::size_t start = help.size();
+                help += '\t';
+                if (nullptr != opt) {
+                    if (not opt->alt_name.empty() and opt->alt_name != opt->name)
+                        help.append(opt->alt_name).append(", ");
+                    help.append(opt->name).append(" ").append(opt->value_info());
                 }
                 else {
-                    _wrong.emplace_back("["s + argv[i] + "] Unkonown argument");
+                    help.append(synopsis);
                 }
+
+                std::size_t length = help.size() - start - 1;
+                if (width <= length)
+                    help.append("\n\t").append(width, ' ');
+                else
+                    help.append(width - length, ' ');
+                help.append(doc).append("\n");
+            };
+
+            if (not _app_description.empty())
+                help.append("DESCRIPTION\n\t").append(_app_description).append("\n\n");
+
+            // SYNOPSIS
+            help.append("SYNOPSIS\n\t");
+            append_command_path(help);
+
+            for (std::size_t slot = 0; slot < _options.size(); slot++)
+                if (_options[slot]->req() and not is_positional(slot))
+                    help.append(" ").append(_options[slot]->alt_name).append(" ").append(_options[slot]->value_info());
+
+            help.append(" [...]");
+            for (std::uint32_t slot : _positionals) {
+                const option_base* opt = _options[slot];
+                help.append(opt->req() ? " " : " [").append(opt->value_info()).append(opt->req() ? "" : "]");
             }
+            help.append(_commands.empty() ? "\n" : " <command> [...]\n");
+            // end SYNOPSIS
 
-            return tokens;
-        }
+            bool flags = _help_flag.is_used() or _version_flag.is_used();
+            bool options = false;
+            for (std::size_t slot = 0; slot < _options.size(); slot++) {
+                if (is_positional(slot))
+                    continue;
+                bool flag = _options[slot]->type() == otype::flag;
+                flags |= flag;
+                options |= not flag;
+            }
 
-        /**
-         * \internal
-         * \brief Sets an option/flag.
-         * \param t Option + value token
-         * \see token
-         */
-        inline void set_option(token t) {
-            using namespace std::string_literals;
+            if (flags) {
+                help.append("\nFLAGS\n");
+                if (_help_flag.is_used())
+                    entry({ }, _help_flag.hndl, _help_flag.hndl->doc());
+                if (_version_flag.is_used())
+                    entry({ }, _version_flag.hndl, _version_flag.hndl->doc());
+                for (std::size_t slot = 0; slot < _options.size(); slot++)
+                    if (_options[slot]->type() == otype::flag and not is_positional(slot))
+                        entry({ }, _options[slot], _options[slot]->doc());
+            }
+
+            if (options) {
+                help.append("\nOPTIONS\n");
+                for (std::size_t slot = 0; slot < _options.size(); slot++)
+                    if (_options[slot]->type() == otype::option and not is_positional(slot))
+                        entry({ }, _options[slot], _options[slot]->doc());
+            }
 
-            try {
-                get_option(t.option)->assign(t.value);
+            if (not _positionals.empty()) {
+                help.append("\nARGUMENTS\n");
+                for (std::uint32_t slot : _positionals)
+                    entry(_options[slot]->value_info(), nullptr, _options[slot]->doc());
             }
-            catch (...) {
-                auto& optn = get_option(t.option);
-                _wrong.emplace_back("["s + t.option.data() + "] Value " + t.value.data() + " is not allowed \n\t{ " + optn->detailed_synopsis() + "  " + optn->doc() + " }");
+
+            if (not _commands.empty()) {
+                help.append("\nCOMMANDS\n");
+                for (const auto& cmd : _commands)
+                    entry(cmd.name, nullptr, cmd.description);
             }
+
+            if (not _license_notice.empty())
+                help.append("\nLICENSE\n\t").append(_license_notice).append("\n");
+
+            if (not _author.empty())
+                help.append("\nAUTHOR\n\t").append(_author).append("\n");
+
+            if (not _web_link.empty())
+                help.append("\n").append(_web_link).append("\n");
         }
 
         /// \internal
-        /// \brief Counts required options/flags.
-        inline std::size_t count_req() const {
-            std::size_t count = 0;
-            for (auto& i : _options)
-                if (i->req())
-                    count++;
+        /// \brief Marks the cached documentation as outdated.
+        inline void help_changed() noexcept
+        { _help_valid = false; }
 
-            return count;
+        /// \internal
+        /// \brief Updates the slot sets after an option was added.
+        inline void added() {
+            _required.resize(_options.size());
+            _given.resize(_options.size());
+            _prepared = false;
+            _layers_ready = false;
+            help_changed();
         }
-        
+
         /// \internal
-        /// \brief Gets an (existing) option with the given key (name).
-        inline bool option_exists(std::string_view key) const
-        { return _names.contains(key); }
+        /// \brief Registers a name of the option that is being added.
+        inline void add_name(std::string_view key) {
+            if (_static_size != 0 and (_options.size() >= _static_size or _static_names.find(key) != _options.size()))
+                CLIPPER_THROW(std::logic_error("Option is not declared in the static schema (or is added out of order)"));
+
+            if (is_short_name(key))
+                _short[static_cast<unsigned char>(key[1])] = static_cast<std::uint32_t>(_options.size() + 1);
+            else if (_static_size == 0)
+                _names[key] = _options.size();
+        }
+
+        /// \internal
+        /// \brief Checks whether a name consists of a '-' and one character (other than '-').
+        static constexpr bool is_short_name(std::string_view key) noexcept
+        { return key.size() == 2 and key[0] == '-' and key[1] != '-'; }
+
+        /// \internal
+        /// \brief Finds the slot of an option with a one-character name (`-c`).
+        /// \return Option slot or \ref detail::npos if there is no such option.
+        inline std::size_t find_short(char c) const noexcept {
+            std::uint32_t entry = _short[static_cast<unsigned char>(c)];
+            return entry == 0 ? detail::npos : entry - 1;
+        }
+
+        /// \internal
+        /// \brief Finds the slot of an option with the given key (name).
+        /// \return Option slot or \ref detail::npos if there is no such option.
+        inline std::size_t find_option(std::string_view key) const {
+            if (is_short_name(key))
+                return find_short(key[1]);
+
+            if (_static_size != 0) {
+                std::size_t slot = _static_names.find(key);
+                return slot < _options.size() ? slot : detail::npos;
+            }
+
+            auto it = _names.find(key);
+            return it == _names.end() ? detail::npos : it->second;
+        }
+
+        /**
+         *  \internal
+         *  \brief Finds the value attached to an option name (`--name=value`).
+         *
+         *  Only called after the whole argument is not a name, so the names containing '=' are matched first.
+         *
+         *  \return Position of the '=' or \ref detail::npos if the argument is not an option (non-flag) with a value.
+         */
+        inline std::size_t find_attached(std::string_view arg) const {
+            std::size_t eq = arg.find('=');
+            if (eq == std::string_view::npos or eq == 0)
+                return detail::npos;
+
+            std::size_t slot = find_option(arg.substr(0, eq));
+            return slot != detail::npos and _options[slot]->type() == otype::option ? eq : detail::npos;
+        }
+
+        /**
+         *  \internal
+         *  \brief Checks whether an argument is a cluster of one-character options (`-xvf`, `-j8`, `-vofile`).
+         *
+         *  Every character up to the first option (non-flag) has to be a one-character name,
+         *  the rest of the argument is the value of that option.
+         *
+         *  \return Position after the last option character (where the value starts), or \ref detail::npos if it is not a cluster.
+         */
+        inline std::size_t find_cluster(std::string_view arg) const noexcept {
+            if (arg.size() < 3 or arg[0] != '-' or arg[1] == '-')
+                return detail::npos;
+
+            for (std::size_t pos = 1; pos < arg.size(); pos++) {
+                std::size_t slot = find_short(arg[pos]);
+                if (detail::npos == slot)
+                    return detail::npos;
+                if (_options[slot]->type() == otype::option)
+                    return pos + 1;
+            }
+            return arg.size();
+        }
+
+        /**
+         *  \internal
+         *  \brief Checks whether an argument looks like an option name (starts with '-').
+         *
+         *  A lone `-` (stdin) and negative numbers (`-3`, `-.5`) do not, so they can still be positional values.
+         *  Unresolved arguments that do are reported as unknown instead of filling a positional argument.
+         */
+        static constexpr bool looks_like_option(std::string_view arg) noexcept {
+            if (arg.size() < 2 or arg[0] != '-')
+                return false;
+
+            auto digit = [](char c) { return c >= '0' and c <= '9'; };
+            return not (digit(arg[1]) or (arg[1] == '.' and arg.size() > 2 and digit(arg[2])));
+        }
 
         /// \internal
-        /// \brief Gets an (existing) option with the given key (name).
-        inline std::unique_ptr<option_base>& get_option(std::string_view key)
-        { return _options[_names.at(key)]; }
+        /// \brief Checks whether an option with the given key (name) exists.
+        inline bool option_exists(std::string_view key) const
+        { return find_option(key) != detail::npos; }
 
         /// \internal
-        /// \brief Checks if an (existing) option is required and not set.
-        inline bool is_req_and_not_set(std::string_view key) const {
-            auto& optn = _options[_names.at(key)];
-            return optn->req() and not optn->is_set();
+        /// \brief Gets an option with the given key (name).
+        /// \return Pointer to the option or nullptr if there is no such option.
+        inline option_base* get_option(std::string_view key) {
+            std::size_t slot = find_option(key);
+            return slot == detail::npos ? nullptr : _options[slot];
         }
         
         /// \internal
@@ -971,13 +5832,13 @@ namespace CLI
 
     private:
     /* internal types */
-    using option_name_map = std::unordered_map<std::string_view, std::size_t>; ///< Container for storing option names.
-        using option_vec = std::vector<std::unique_ptr<option_base>>; ///< Container for storing options.
+    using option_name_map = std::pmr::unordered_map<std::string_view, std::size_t>; ///< Container for storing option names.
+        using option_vec = std::pmr::vector<option_base*>; ///< Container for storing options (owned by the arena).
 
         /// \brief Contains a \ref option<bool> "flag" information.
         /// \brief Primarly for version and help flags.
         struct helper_flag {
-            std::unique_ptr<option<bool>> hndl; ///< \ref option<bool> "Flag" handle.
+            option<bool>* hndl = nullptr; ///< \ref option<bool> "Flag" handle (owned by the arena).
 
             /**
              *  \brief Compares string with name and alt_name.
@@ -995,6 +5856,7 @@ namespace CLI
             { return hndl != nullptr; }
         };
 
+        std::pmr::memory_resource* _resource = std::pmr::get_default_resource(); ///< Source of all allocations (initialized first).
         std::string_view _app_name;
         std::string_view _app_description;
         std::string_view _version;
@@ -1003,14 +5865,147 @@ namespace CLI
         std::string_view _web_link;
         helper_flag _help_flag;
         helper_flag _version_flag;
+        detail::arena _arena { _resource }; ///< Owns all options and flags.
         arg_count _args_count { }; ///< Contains the argument count.
         bool _allow_no_args { false }; ///< Determines whether the app can be used without giving any arguments. \ref allow_no_args() "See more"
-        option_name_map _names; ///< Contains option names.
-        option_vec _options; ///< Contains all options.
-        std::vector<std::string> _wrong; ///< Contains all errors encountered while parsing.
+        option_name_map _names { _resource }; ///< Contains option names (unused with a static schema), except the one-character ones.
+        std::array<std::uint32_t, 256> _short { }; ///< Slots (+1, 0 if none) of the options with one-character names, indexed by the character.
+        detail::static_name_index _static_names; ///< Compile-time name table. \ref static_schema "See more"
+        std::size_t _static_size { }; ///< Number of options declared in the static schema (0 if not used).
+        option_vec _options { _resource }; ///< Contains all options.
+        detail::arg_list _args; ///< Arguments of the last parse (used to format errors).
+        detail::response_files _response { _resource }; ///< Arguments expanded from response files.
+        bool _response_files { false }; ///< Determines whether `@file` arguments are expanded. \ref allow_response_files() "See more"
+        std::pmr::string _env_prefix { _resource }; ///< Prefix of the environment variables. \ref env_prefix() "See more"
+        std::pmr::string _config_path { _resource }; ///< Path of the configuration file. \ref config_file() "See more"
+        detail::mapped_file _config; ///< Loaded configuration file (values refer to it).
+        std::pmr::string _env_keys { _resource }; ///< Names of the environment variables (one after another).
+        option_name_map _env_names { _resource }; ///< Environment variable names (slots).
+        option_name_map _config_names { _resource }; ///< Names used in the configuration file (slots).
+        std::pmr::vector<std::string_view> _layer_values { _resource }; ///< Values from the environment or the file (no data if there is none).
+        std::pmr::vector<std::string_view> _layer_keys { _resource }; ///< Variable or name the values come from.
+        std::pmr::vector<std::uint32_t> _layer_lines { _resource }; ///< Line of the file the values come from (none for the environment).
+        bool _layers_ready { false }; ///< True if the names of the environment and the file are up to date.
+        std::pmr::vector<parse_error> _errors { _resource }; ///< Contains all errors encountered while parsing.
+        mutable std::pmr::vector<std::pmr::string> _wrong { _resource }; ///< Formatted errors (created on demand).
+        std::pmr::vector<group> _groups { _resource }; ///< Constraint groups.
+        detail::slot_set _required { _resource }; ///< Required options.
+        detail::slot_set _given { _resource }; ///< Options given in the last parse.
+        bool _prepared { false }; ///< True if the slot sets are up to date with the options.
+        std::pmr::vector<command_entry> _commands { _resource }; ///< Subcommands.
+        clipper* _selected { nullptr }; ///< Subcommand selected by the last parse.
+        const clipper* _parent { nullptr }; ///< Instance that this one is a subcommand of.
+        std::pmr::vector<std::uint32_t> _positionals { _resource }; ///< Slots of the positional arguments (in order).
+        std::span<const char* const> _passthrough; ///< Arguments after `--` in the last parse.
+        mutable std::pmr::string _help { _resource }; ///< Documentation (created on demand). \ref help_text() "See more"
+        mutable bool _help_valid { false }; ///< True if the documentation is up to date.
+        std::string_view _static_help; ///< Documentation set by \ref help_text(std::string_view).
+#if CLIPPER_INSTRUMENT
+        parse_observer* _observer { nullptr }; ///< Observer of parsing (\ref observe()).
+#endif
     };
 
 
+    inline bool parse_result::is_set(std::string_view name) const noexcept
+    { return given_slot(name) != detail::npos; }
+
+    inline std::string_view parse_result::value(std::string_view name) const noexcept {
+        std::size_t slot = given_slot(name);
+        return slot == detail::npos ? std::string_view() : _values[slot];
+    }
+
+    template<option_types Tp>
+    inline std::optional<Tp> parse_result::get(std::string_view name) const {
+        std::size_t slot = given_slot(name);
+        Tp val;
+        if (detail::npos == slot or read_slot(slot, val) != assign_status::ok)
+            return std::nullopt;
+        return val;
+    }
+
+    template<option_types Tp>
+    inline assign_status parse_result::read(std::string_view name, Tp& out) const {
+        std::size_t slot = given_slot(name);
+        if (detail::npos == slot)
+            return assign_status::ok;
+
+        Tp val;
+        assign_status status = read_slot(slot, val);
+        if (status == assign_status::ok)
+            out = std::move(val);
+        return status;
+    }
+
+    template<option_types Tp>
+    inline assign_status parse_result::read_slot(std::size_t slot, Tp& out) const {
+        const option_base* opt = _schema->_options[slot];
+        if constexpr (std::is_same_v<Tp, bool>) {
+            if (opt->type() == otype::flag) {
+                out = true;
+                return assign_status::ok;
+            }
+        }
+        else if (opt->tag() == detail::type_tag<Tp> and (detail::type_tag<Tp> != detail::untagged or dynamic_cast<const option<Tp>*>(opt))) {
+            const auto* typed = static_cast<const option<Tp>*>(opt);
+            return _lazy ? typed->read(_values[slot], out) : typed->convert(_values[slot], out);
+        }
+        return assign_status::invalid_value;
+    }
+
+    inline std::string parse_result::format_error(const parse_error& err) const
+    { return _schema->format_error(err, _args); }
+
+    inline std::string batch_result::format_error(std::size_t line, const parse_error& err) const {
+        const failure* f = find_failure(line);
+        if (nullptr == f)
+            return { };
+        return _schema->format_error(err, { nullptr, _args.data() + f->first_arg, f->arg_count });
+    }
+
+    inline std::span<const std::string_view> batch_result::column(std::string_view name) const noexcept {
+        std::size_t slot = find_slot(name);
+        return detail::npos == slot ? std::span<const std::string_view>() : std::span(_values).subspan(slot * _lines, _lines);
+    }
+
+    inline bool batch_result::is_set(std::size_t line, std::string_view name) const noexcept {
+        std::size_t slot = find_slot(name);
+        return detail::npos != slot and line < _lines and _given[slot * _lines + line];
+    }
+
+    inline std::string_view batch_result::value(std::size_t line, std::string_view name) const noexcept
+    { return is_set(line, name) ? _values[find_slot(name) * _lines + line] : std::string_view(); }
+
+    template<option_types Tp>
+    inline std::optional<Tp> batch_result::get(std::size_t line, std::string_view name) const {
+        if (not is_set(line, name))
+            return std::nullopt;
+
+        std::size_t slot = find_slot(name);
+        const option_base* opt = _schema->_options[slot];
+        if constexpr (std::is_same_v<Tp, bool>) {
+            if (opt->type() == otype::flag)
+                return true;
+        }
+        else if (opt->tag() == detail::type_tag<Tp> and (detail::type_tag<Tp> != detail::untagged or dynamic_cast<const option<Tp>*>(opt))) {
+            Tp val;
+            if (static_cast<const option<Tp>*>(opt)->convert(_values[slot * _lines + line], val) == assign_status::ok)
+                return val;
+        }
+        return std::nullopt;
+    }
+
+    inline std::size_t batch_result::find_slot(std::string_view name) const noexcept
+    { return nullptr == _schema ? detail::npos : _schema->find_named(name); }
+
+    inline std::size_t parse_result::given_slot(std::string_view name) const noexcept {
+        if (nullptr == _schema)
+            return detail::npos;
+
+        std::size_t slot = _schema->find_named(name);
+        return slot != detail::npos and _given.test(slot) ? slot : detail::npos;
+    }
+
+
     /**
      * \brief Inline namespace that contains template predicates for \ref option<Tp> "options".
      * \see numeric option<Tp> option<Tp>::predicate option<Tp>::validate()
@@ -0,0 +1,185 @@
+// Replaces the global operator new, built as a separate executable, see CMakeLists.txt
+#include <gtest/gtest.h>
+#include "clipper.hpp"
+#include <array>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+using namespace CLI;
+
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+
+/// Counts the allocations made during its lifetime.
+class allocation_counter {
+public:
+    allocation_counter() : _start(allocations) {}
+    std::size_t count() const { return allocations - _start; }
+
+private:
+    std::size_t _start;
+};
+
+
+class AllocationTest : public ::testing::Test {
+protected:
+    AllocationTest() {
+        cli.add_flag("--verbose", "-v").set(verbose);
+        cli.add_flag("--quiet", "-q").set(quiet);
+        cli.add_flag("--force", "-f").set(force);
+        cli.add_option<int>("--number", "-n").set("num", num).match(1, 2, 3, 42).req();
+        cli.add_option<long long>("--size", "-s").set("size", size).validate("[0; 1M]", ibetween<0LL, 1000000LL>);
+        cli.add_option<double>("--ratio", "-r").set("ratio", ratio);
+        cli.add_option<char>("--mode", "-m").set("mode", mode).match('a', 'b', 'c');
+        cli.add_option<std::string>("--text", "-t").set("text", text);
+        cli.mutually_exclusive("--verbose", "--quiet");
+        cli.compile();
+    }
+
+    template<std::size_t N>
+    std::size_t parse(const char* const (&args)[N]) {
+        allocation_counter counter;
+        cli.parse(N, args);
+        return counter.count();
+    }
+
+    template<std::size_t N>
+    std::size_t parse(const char* const (&args)[N], parse_result& res) {
+        allocation_counter counter;
+        std::as_const(cli).parse(N, args, res);
+        return counter.count();
+    }
+
+    clipper cli { "app" };
+    bool verbose, quiet, force;
+    int num;
+    long long size;
+    double ratio;
+    char mode;
+    std::string text;
+};
+
+
+TEST_F(AllocationTest, FlagsOnly) {
+    const char* args[] { "app", "-v", "--force", "-n", "1" };
+    EXPECT_EQ(parse(args), 0);
+    EXPECT_TRUE(verbose);
+    EXPECT_TRUE(force);
+}
+
+TEST_F(AllocationTest, IntegralOptions) {
+    const char* args[] { "app", "-n", "42", "--size", "1000", "-m", "b", "-r", "0.5" };
+    EXPECT_EQ(parse(args), 0);
+    EXPECT_EQ(num, 42);
+    EXPECT_EQ(size, 1000);
+    EXPECT_EQ(mode, 'b');
+}
+
+TEST_F(AllocationTest, StringOptions) {
+    const char* shrt[] { "app", "-n", "1", "-t", "short" };
+    EXPECT_EQ(parse(shrt), 0); // fits in SSO
+
+    const char* lng[] { "app", "-n", "1", "-t", "a-longer-string-value-that-does-not-fit-sso" };
+    parse(lng);
+    EXPECT_EQ(parse(lng), 0); // the capacity is reused
+    EXPECT_EQ(text, "a-longer-string-value-that-does-not-fit-sso");
+}
+
+TEST_F(AllocationTest, ViewOptions) {
+    std::string_view name;
+    path_view file;
+    cli.add_option<std::string_view>("--name").set("name", name);
+    cli.add_option<path_view>("--file").set("file", file);
+    cli.compile();
+
+    const char* args[] { "app", "-n", "1", "--name", "a-longer-string-value-that-does-not-fit-sso", "--file", "/usr/local/share/clipper/data/input.txt" };
+    EXPECT_EQ(parse(args), 0); // the first parse too
+    EXPECT_EQ(name.data(), args[4]);
+    EXPECT_EQ(file.data(), args[6]);
+}
+
+TEST_F(AllocationTest, ListOptions) {
+    std::vector<int> ids;
+    cli.add_option<std::vector<int>>("--ids").set("id", ids).reserve(8);
+    cli.compile();
+
+    const char* args[] { "app", "-n", "1", "--ids", "1,2,3,4", "--ids", "5,6,7,8" };
+    EXPECT_EQ(parse(args), 0); // reserved
+    EXPECT_EQ(ids.size(), 8u);
+
+    const char* more[] { "app", "-n", "1", "--ids", "1,2,3,4,5,6,7,8,9,10,11,12" };
+    cli.reset();
+    parse(more);
+    cli.reset();
+    EXPECT_EQ(parse(more), 0); // the capacity is kept
+}
+
+TEST_F(AllocationTest, Reparse) {
+    const char* args[] { "app", "-v", "-n", "2", "-t", "a-longer-string-value-that-does-not-fit-sso" };
+    parse(args);
+
+    allocation_counter counter;
+    for (int i = 0; i < 100; i++) {
+        cli.reset();
+        cli.parse(std::size(args), args);
+    }
+    EXPECT_EQ(counter.count(), 0);
+}
+
+TEST_F(AllocationTest, Errors) {
+    const char* args[] { "app", "-v", "-q", "--unknown", "-n", "7", "-s" };
+    parse(args); // the error list grows once
+    EXPECT_EQ(parse(args), 0);
+    EXPECT_EQ(cli.errors().size(), 4);
+}
+
+TEST_F(AllocationTest, ParseResult) {
+    parse_result res;
+    const char* args[] { "app", "-v", "-n", "3", "-t", "a-longer-string-value-that-does-not-fit-sso" };
+    parse(args, res); // the result grows once
+    EXPECT_EQ(parse(args, res), 0);
+    EXPECT_TRUE(res.ok());
+    EXPECT_EQ(res.value("-t"), "a-longer-string-value-that-does-not-fit-sso");
+}
+
+TEST(AllocationResourceTest, MonotonicBuffer) {
+    std::array<std::byte, 32 * 1024> buffer;
+    std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    bool verbose;
+    int num;
+    std::string charset;
+    allocation_counter counter;
+    {
+        clipper cli("app", &resource);
+        cli.help_flag("--help", "-h");
+        cli.add_flag("--verbose", "-v").set(verbose).doc("Prints more information about what the application is doing");
+        cli.add_option<int>("--number", "-n").set("num", num).match(1, 2, 3).doc("Number of the iterations to perform").req();
+        cli.add_option<std::string>("--charset", "-c").set("charset", charset)
+            .match("utf8", "utf16", "a charset name that does not fit in the small string buffer")
+            .doc("Character set of the input files that are going to be processed");
+        cli.mutually_exclusive("--verbose", "--charset");
+        EXPECT_EQ(cli.resource(), &resource);
+
+        const char* args[] { "app", "-v", "-n", "2" };
+        EXPECT_TRUE(cli.parse(std::size(args), args));
+
+        const char* wrong[] { "app", "-v", "-c", "utf8", "--unknown", "-n", "7" };
+        EXPECT_FALSE(cli.parse(std::size(wrong), wrong));
+        EXPECT_EQ(cli.errors().size(), 3u);
+
+        parse_result res(&resource);
+        EXPECT_TRUE(std::as_const(cli).parse(std::size(args), args, res));
+    }
+    EXPECT_EQ(counter.count(), 0u);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "clipper.hpp"
+#include <thread>
+#include <fstream>
 using namespace CLI;
 
 class ClipperTest : public testing::Test {
@@ -437,4 +439,1107 @@ TEST_F(ClipperTest, NoArgs) {
         cli.parse(8, argv2);
         ASSERT_FALSE(cli.no_args());
     });
-}
\ No newline at end of file
+}
+
+TEST_F(ClipperTest, ParsingManyArguments) {
+    std::vector<const char*> argv { "app", "-i", "in.txt", "-o", "out.txt", "-f" };
+    for (int i = 0; i < 5000; i++) {
+        argv.push_back("--count");
+        argv.push_back(i % 2 ? "7" : "8");
+        argv.push_back("-v");
+    }
+    argv.push_back(nullptr);
+
+    EXPECT_NO_THROW({
+        ASSERT_TRUE(cli.parse(static_cast<arg_count>(argv.size() - 1), argv.data())) << ParsingWrong();
+    });
+    EXPECT_EQ(c_v, 7);
+    EXPECT_TRUE(v_v);
+}
+
+TEST_F(ClipperTest, MissingRequiredList) {
+    const char* argv[] = { "app", "-i", "in.txt", "-c", "5", nullptr };
+    EXPECT_NO_THROW({
+        ASSERT_FALSE(cli.parse(5, argv));
+    });
+    EXPECT_EQ(ParsingWrong(), "[-o] Missing required argument\n[-f] Missing required argument\n");
+}
+
+TEST_F(ClipperTest, ConstraintGroups) {
+    cli.mutually_exclusive("--name", "-e", "--myvalue");
+    cli.require_one_of("-l", "-s");
+    cli.require_all_of("--verbose", "-h");
+
+    const char* argv[] = { "app", "-i", "in", "-o", "out", "-c", "5", "-f", "-l", "1", nullptr };
+    EXPECT_NO_THROW({
+        EXPECT_TRUE(cli.parse(10, argv)) << ParsingWrong();
+    });
+
+    const char* argv2[] = { "app", "-i", "in", "-o", "out", "-c", "5", "-f", "-n", "a", "-m", "1", "-v", nullptr };
+    EXPECT_NO_THROW({
+        ASSERT_FALSE(cli.parse(13, argv2));
+    });
+    EXPECT_EQ(ParsingWrong(),
+        "[--name --encoding --myvalue] Options are mutually exclusive\n"
+        "[-l -s] One of the options is required\n"
+        "[--verbose -h] Options have to be used together\n");
+
+    EXPECT_ANY_THROW(cli.mutually_exclusive("--name", "--unknown"));
+}
+
+TEST_F(ClipperTest, StructuredErrors) {
+    const char* argv[] = { "app", "-i", "in.txt", "-x", "-c", "abc", "-o", "out.txt", "-f", "-l", nullptr };
+    EXPECT_NO_THROW({
+        ASSERT_FALSE(cli.parse(10, argv));
+    });
+
+    const auto& errs = cli.errors();
+    ASSERT_EQ(errs.size(), 3u);
+    EXPECT_EQ(errs[0].kind, error_kind::unknown_argument);
+    EXPECT_EQ(errs[0].index, 3u);
+    EXPECT_EQ(errs[1].kind, error_kind::invalid_value);
+    EXPECT_EQ(errs[1].index, 4u);
+    EXPECT_EQ(errs[1].slot, 2u);
+    EXPECT_EQ(errs[2].kind, error_kind::missing_value);
+    EXPECT_EQ(errs[2].index, 9u);
+
+    EXPECT_EQ(cli.format_error(errs[0]), "[-x] Unkonown argument");
+    EXPECT_EQ(cli.wrong().size(), 3u);
+    EXPECT_EQ(cli.wrong()[2], "[-l] Missing option value");
+
+    // errors of the previous parse are discarded
+    const char* argv2[] = { "app", "-i", "in.txt", "-o", "out.txt", "-c", "5", "-f", nullptr };
+    EXPECT_NO_THROW({
+        EXPECT_TRUE(cli.parse(8, argv2)) << ParsingWrong();
+    });
+    EXPECT_TRUE(cli.errors().empty());
+    EXPECT_TRUE(cli.wrong().empty());
+}
+
+TEST_F(ClipperTest, Reset) {
+    const char* argv[] = { "app", "-i", "in.txt", "-o", "out.txt", "-c", "5", "-f", "-n", "name", "-v", "-x", nullptr };
+    EXPECT_NO_THROW({
+        EXPECT_FALSE(cli.parse(12, argv));
+    });
+    EXPECT_EQ(n_v, "name");
+    EXPECT_TRUE(v_v);
+
+    cli.reset();
+    EXPECT_TRUE(cli.errors().empty());
+    EXPECT_EQ(n_v, "");
+    EXPECT_FALSE(v_v);
+    EXPECT_EQ(c_v, 0);
+
+    const char* argv2[] = { "app", "-i", "in2.txt", "-o", "out2.txt", "-c", "6", "-f", nullptr };
+    for (int i = 0; i < 3; i++) {
+        EXPECT_NO_THROW({
+            EXPECT_TRUE(cli.parse(8, argv2)) << ParsingWrong();
+        });
+        EXPECT_EQ(i_v, "in2.txt");
+        EXPECT_EQ(c_v, 6);
+        EXPECT_EQ(n_v, "");
+        EXPECT_FALSE(v_v);
+        cli.reset();
+    }
+}
+
+TEST_F(ClipperTest, ParseResult) {
+    const clipper& schema = cli.compile();
+    parse_result res;
+
+    const char* argv[] = { "app", "-i", "in.txt", "-o", "out.txt", "-c", "42", "-f", "--myvalue", "2.5", nullptr };
+    EXPECT_NO_THROW({
+        ASSERT_TRUE(schema.parse(10, argv, res));
+    });
+    EXPECT_TRUE(res.ok());
+    EXPECT_TRUE(res.is_set("--input"));
+    EXPECT_TRUE(res.is_set("-f"));
+    EXPECT_FALSE(res.is_set("-v"));
+    EXPECT_FALSE(res.is_set("--unknown"));
+    EXPECT_EQ(res.value("-i"), "in.txt");
+    EXPECT_EQ(res.get<std::string>("--input"), "in.txt");
+    EXPECT_EQ(res.get<std::filesystem::path>("-o"), "out.txt");
+    EXPECT_EQ(res.get<int>("--count"), 42);
+    EXPECT_EQ(res.get<double>("-m"), 2.5);
+    EXPECT_EQ(res.get<bool>("--flag"), true);
+    EXPECT_EQ(res.get<int>("--input"), std::nullopt); // different type
+    EXPECT_EQ(res.get<int>("-l"), std::nullopt);      // not given
+
+    // bound variables are not touched
+    EXPECT_EQ(i_v, "");
+    EXPECT_EQ(c_v, 0);
+
+    const char* argv2[] = { "app", "-i", "in.txt", "-c", "x", "-y", nullptr };
+    EXPECT_NO_THROW({
+        ASSERT_FALSE(schema.parse(6, argv2, res));
+    });
+    ASSERT_EQ(res.errors().size(), 4u);
+    EXPECT_EQ(res.format_error(res.errors()[1]), "[-y] Unkonown argument");
+    EXPECT_TRUE(cli.errors().empty());
+
+    const char* argv3[] = { "app", "--help", nullptr };
+    EXPECT_TRUE(schema.parse(2, argv3, res));
+    EXPECT_TRUE(res.help());
+    EXPECT_FALSE(help_v);
+}
+
+TEST_F(ClipperTest, LazyParseResult) {
+    std::size_t level;
+    cli.add_option<std::size_t>("--level").set("", level).validate(rules::ibetween<1, 9>);
+    const clipper& schema = cli.compile();
+    parse_result res;
+    res.lazy();
+
+    const char* argv[] = { "app", "-i", "in.txt", "-o", "out.txt", "-c", "x", "-f", "--level", "12", "-m", "0.5", nullptr };
+    ASSERT_TRUE(schema.parse(12, argv, res)); // values are not checked
+    EXPECT_TRUE(res.lazy());
+    EXPECT_EQ(res.get<int>("-c"), std::nullopt);
+    EXPECT_EQ(res.get<std::size_t>("--level"), std::nullopt);
+    EXPECT_EQ(res.get<double>("-m"), 0.5);
+
+    int count = 7;
+    EXPECT_EQ(res.read("-c", count), assign_status::invalid_value);
+    EXPECT_EQ(count, 7);
+    std::size_t lvl = 1;
+    EXPECT_EQ(res.read("--level", lvl), assign_status::not_allowed);
+    EXPECT_EQ(res.read("-l", lvl), assign_status::ok); // not given, keeps the default
+    EXPECT_EQ(lvl, 1u);
+    std::string input;
+    EXPECT_EQ(res.read("-i", input), assign_status::ok);
+    EXPECT_EQ(input, "in.txt");
+
+    const char* argv2[] = { "app", "-i", "in.txt", "-c", "x", "-y", nullptr };
+    ASSERT_FALSE(schema.parse(6, argv2, res));
+    EXPECT_EQ(res.errors().size(), 3u); // -y, -o, -f
+
+    res.lazy(false);
+    EXPECT_FALSE(schema.parse(12, argv, res));
+    EXPECT_EQ(res.errors().size(), 2u);
+    EXPECT_EQ(res.get<std::size_t>("--level"), 12u); // only converted, the parse reported the error
+}
+
+TEST_F(ClipperTest, ConcurrentParsing) {
+    const clipper& schema = cli.compile();
+    std::vector<std::thread> workers;
+    std::vector<int> failures(4);
+
+    for (int w = 0; w < 4; w++) {
+        workers.emplace_back([&schema, &failures, w] {
+            std::string count = std::to_string(w);
+            const char* argv[] = { "app", "-i", "in.txt", "-o", "out.txt", "-c", count.c_str(), "-f", nullptr };
+            parse_result res;
+
+            for (int i = 0; i < 1000; i++)
+                if (not schema.parse(8, argv, res) or res.get<int>("-c") != w)
+                    failures[w]++;
+        });
+    }
+
+    for (auto& t : workers)
+        t.join();
+
+    for (int f : failures)
+        EXPECT_EQ(f, 0);
+}
+
+TEST_F(ClipperTest, BatchParsing) {
+    std::string lines;
+    for (int i = 0; i < 2000; i++) {
+        if (i % 100 == 7)
+            lines += "-i in -o out -f -c x" + std::to_string(i) + "\n";
+        else if (i % 100 == 8)
+            lines += "-i in -o out -c 1\n"; // missing required flag
+        else
+            lines += "-i \"in " + std::to_string(i) + "\" -o out -f --count=" + std::to_string(i) + (i % 2 ? " -v" : "") + "\r\n";
+    }
+    lines += "--help";
+
+    cli.compile();
+    for (unsigned threads : { 1u, 4u }) {
+        batch_result res;
+        EXPECT_FALSE(cli.parse_batch(lines, res, threads));
+        ASSERT_EQ(res.size(), 2001u);
+        ASSERT_EQ(res.failed().size(), 40u);
+        EXPECT_EQ(res.failed()[0], 7u);
+        EXPECT_EQ(res.failed()[1], 8u);
+        EXPECT_EQ(res.failed().back(), 1908u);
+
+        ASSERT_EQ(res.errors(107).size(), 1u);
+        EXPECT_EQ(res.errors(107)[0].kind, error_kind::invalid_value);
+        EXPECT_EQ(res.format_error(107, res.errors(107)[0]), "[-c] Value x107 is not allowed \n\t{ -c, --count <>   }");
+        EXPECT_EQ(res.format_error(8, res.errors(8)[0]), "[-f] Missing required argument");
+        EXPECT_TRUE(res.errors(9).empty());
+
+        auto inputs = res.column("--input");
+        ASSERT_EQ(inputs.size(), 2001u);
+        EXPECT_EQ(inputs[1999], "in 1999");
+        EXPECT_EQ(inputs[2000], "");
+        EXPECT_TRUE(res.ok(2000));
+        EXPECT_TRUE(res.is_set(1, "-v"));
+        EXPECT_FALSE(res.is_set(2, "-v"));
+        EXPECT_EQ(res.get<int>(1234, "-c"), 1234);
+        EXPECT_EQ(res.get<bool>(1, "--verbose"), true);
+        EXPECT_EQ(res.value(5, "-o"), "out");
+        EXPECT_TRUE(res.column("--unknown").empty());
+    }
+
+    EXPECT_EQ(c_v, 0); // bound variables are not modified
+    EXPECT_TRUE(i_v.empty());
+
+    auto path = std::filesystem::temp_directory_path() / "clipper_batch.txt";
+    std::ofstream(path, std::ios::binary) << "-i a -o b -f -c 1\n\n-i a -o b -f -c 2";
+    batch_result res;
+    EXPECT_FALSE(cli.parse_batch_file(path.c_str(), res)); // an empty line
+    EXPECT_EQ(res.size(), 3u);
+    EXPECT_EQ(res.failed(), (std::pmr::vector<std::size_t> { 1 }));
+    EXPECT_EQ(res.get<int>(2, "-c"), 2);
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(cli.parse_batch_file("/nonexistent/clipper.txt", res));
+    EXPECT_EQ(res.size(), 0u);
+}
+
+TEST(ClipperCommandTest, Subcommands) {
+    bool verbose = false, help = false, release = false;
+    int jobs = 1;
+    std::string filter;
+    int setups = 0;
+
+    clipper cli("tool");
+    cli.add_flag("--verbose", "-v").set(verbose);
+    cli.help_flag("--help").set(help);
+    cli.add_command("build", "builds the project", [&](clipper& cmd) {
+        setups++;
+        cmd.add_option<int>("--jobs", "-j").set("n", jobs).doc("number of jobs");
+        cmd.add_flag("--release").set(release);
+    });
+    cli.add_command("test", [&](clipper& cmd) {
+        setups++;
+        cmd.add_option<std::string>("--filter").set("pattern", filter).req();
+        cmd.allow_no_args();
+    });
+    EXPECT_EQ(setups, 0);
+
+    const char* argv[] = { "tool", "-v", "build", "-j8", "--release", nullptr };
+    ASSERT_TRUE(cli.parse(5, argv)) << cli.wrong().front();
+    EXPECT_EQ(setups, 1); // only the selected command
+    ASSERT_NE(cli.command(), nullptr);
+    EXPECT_EQ(cli.command()->name(), "build");
+    EXPECT_TRUE(verbose);
+    EXPECT_TRUE(release);
+    EXPECT_EQ(jobs, 8);
+
+    const char* argv2[] = { "tool", "build", "-j", "x", "-v", nullptr };
+    EXPECT_FALSE(cli.parse(5, argv2));
+    EXPECT_EQ(setups, 1); // created once
+    ASSERT_EQ(cli.wrong().size(), 2u);
+    EXPECT_EQ(cli.wrong()[0], "[-j] Value x is not allowed \n\t{ -j, --jobs <n>  number of jobs }");
+    EXPECT_EQ(cli.wrong()[1], "[-v] Unkonown argument"); // options of the tool come before the command
+
+    const char* argv3[] = { "tool", "-x", "test", nullptr };
+    EXPECT_FALSE(cli.parse(3, argv3));
+    EXPECT_EQ(cli.command(), nullptr);
+    EXPECT_EQ(cli.wrong().front(), "[-x] Unkonown argument");
+    EXPECT_EQ(setups, 1);
+
+    const char* argv4[] = { "tool", "test", nullptr };
+    EXPECT_TRUE(cli.parse(2, argv4)); // allowed without arguments
+    EXPECT_EQ(setups, 2);
+
+    const char* argv5[] = { "tool", "build", "--help", nullptr };
+    ASSERT_TRUE(cli.parse(3, argv5));
+    EXPECT_TRUE(help);
+    std::string build_help = cli.command()->make_help();
+    EXPECT_NE(build_help.find("DESCRIPTION\n\tbuilds the project"), std::string::npos);
+    EXPECT_NE(build_help.find("SYNOPSIS\n\ttool build [...]"), std::string::npos);
+    EXPECT_NE(build_help.find("--release"), std::string::npos);
+    EXPECT_EQ(build_help.find("--verbose"), std::string::npos);
+
+    std::string tool_help = cli.make_help();
+    EXPECT_NE(tool_help.find("SYNOPSIS\n\ttool [...] <command> [...]"), std::string::npos);
+    EXPECT_NE(tool_help.find("COMMANDS\n\tbuild"), std::string::npos);
+    EXPECT_EQ(tool_help.find("--release"), std::string::npos);
+
+    cli.reset();
+    EXPECT_EQ(jobs, 0); // the default
+    EXPECT_FALSE(release);
+
+    parse_result res;
+    EXPECT_FALSE(std::as_const(cli).parse(5, argv, res)); // not dispatched
+    EXPECT_EQ(res.format_error(res.errors().front()), "[build] Unkonown argument");
+}
+
+TEST(ClipperCommandTest, NestedSubcommands) {
+    bool verbose = false;
+    clipper cli("tool");
+    cli.add_command("cmd", [&](clipper& cmd) {
+        cmd.add_command("sub", [&](clipper& sub) { sub.add_flag("--verbose").set(verbose); });
+    });
+
+    const char* argv[] = { "tool", "cmd", "sub", "--verbose", nullptr };
+    ASSERT_TRUE(cli.parse(4, argv)) << cli.wrong().front();
+    ASSERT_NE(cli.command(), nullptr);
+    ASSERT_NE(cli.command()->command(), nullptr);
+    EXPECT_TRUE(verbose);
+
+    std::string help = cli.command()->command()->make_help();
+    EXPECT_NE(help.find("SYNOPSIS\n\ttool cmd sub [...]"), std::string::npos) << help;
+}
+
+TEST(CompletionTrieTest, Prefixes) {
+    const std::string_view words[] = { "--verbose", "--version", "-v", "--value", "build", "--verbose", "" };
+    detail::completion_trie trie;
+    trie.build(words);
+
+    auto find = [&trie](std::string_view prefix) {
+        std::vector<std::string> found;
+        trie.find(prefix, [&found](std::string_view w) { found.emplace_back(w); });
+        return found;
+    };
+    EXPECT_EQ(find(""), (std::vector<std::string> { "--value", "--verbose", "--version", "-v", "build" }));
+    EXPECT_EQ(find("--ver"), (std::vector<std::string> { "--verbose", "--version" }));
+    EXPECT_EQ(find("--version"), (std::vector<std::string> { "--version" }));
+    EXPECT_EQ(find("-v"), (std::vector<std::string> { "-v" }));
+    EXPECT_TRUE(find("--versions").empty());
+    EXPECT_TRUE(find("x").empty());
+}
+
+TEST(EditDistanceTest, MatchesDynamicProgramming) {
+    auto levenshtein = [](std::string_view a, std::string_view b) {
+        std::vector<std::size_t> row(b.size() + 1);
+        for (std::size_t j = 0; j <= b.size(); j++)
+            row[j] = j;
+        for (std::size_t i = 1; i <= a.size(); i++) {
+            std::size_t diag = row[0];
+            row[0] = i;
+            for (std::size_t j = 1; j <= b.size(); j++) {
+                std::size_t up = row[j];
+                row[j] = std::min({ row[j] + 1, row[j - 1] + 1, diag + (a[i - 1] != b[j - 1]) });
+                diag = up;
+            }
+        }
+        return row[b.size()];
+    };
+
+    unsigned state = 7;
+    auto word = [&state](std::size_t max) {
+        state = state * 1103515245u + 12345u;
+        std::string w((state >> 16) % (max + 1), 'a');
+        for (char& c : w) {
+            state = state * 1103515245u + 12345u;
+            c = "abc-"[(state >> 16) % 4];
+        }
+        return w;
+    };
+
+    for (int n = 0; n < 2000; n++) {
+        std::string a = word(64), b = word(70);
+        detail::edit_distance distance(a);
+        for (std::size_t bound : { 0u, 1u, 3u, 100u }) {
+            std::size_t expected = levenshtein(a, b);
+            ASSERT_EQ(distance(b, bound), expected <= bound ? expected : bound + 1) << a << ' ' << b << ' ' << bound;
+        }
+    }
+    EXPECT_EQ(detail::edit_distance("--verbos")("--verbose", 2), 1u);
+    EXPECT_EQ(detail::edit_distance(std::string(65, 'a'))(std::string(65, 'a'), 2), 3u); // too long
+}
+
+TEST(ClipperSuggestionTest, Messages) {
+    std::string format;
+    int level;
+    bool verbose;
+
+    clipper cli("tool");
+    cli.add_flag("--verbose", "-v").set(verbose);
+    cli.add_flag("--version").set(verbose);
+    cli.add_option<std::string>("--format", "-f").set("fmt", format).match("json", "jsonl", "text", "yaml");
+    cli.add_option<int>("--level").set("n", level).match(10, 20, 30);
+    cli.add_command("build", [](clipper& cmd) { cmd.allow_no_args(); });
+
+    const char* argv[] = { "tool", "--verbos", "--fromat=json", "-f", "jsn", "--level", "21", "biuld", "--zzz", "-q", nullptr };
+    ASSERT_FALSE(cli.parse(10, argv));
+    ASSERT_EQ(cli.wrong().size(), 7u);
+    EXPECT_EQ(cli.wrong()[0], "[--verbos] Unkonown argument (did you mean --verbose?)");
+    EXPECT_EQ(cli.wrong()[1], "[--fromat=json] Unkonown argument (did you mean --format?)");
+    EXPECT_EQ(cli.wrong()[2], "[-f] Value jsn is not allowed \n\t{ -f, --format (json jsonl text yaml)   } (did you mean json?)");
+    EXPECT_EQ(cli.wrong()[3], "[--level] Value 21 is not allowed \n\t{ --level (10 20 30)   } (did you mean 20?)");
+    EXPECT_EQ(cli.wrong()[4], "[biuld] Unkonown argument"); // two edits are too many for a five-letter word
+    EXPECT_EQ(cli.wrong()[5], "[--zzz] Unkonown argument");
+    EXPECT_EQ(cli.wrong()[6], "[-q] Unkonown argument"); // one-character names are not suggested
+
+    const char* argv2[] = { "tool", "--versio", nullptr };
+    ASSERT_FALSE(cli.parse(2, argv2));
+    EXPECT_EQ(cli.wrong().front(), "[--versio] Unkonown argument (did you mean --version?)");
+
+    const char* argv3[] = { "tool", "--versone", nullptr };
+    ASSERT_FALSE(cli.parse(2, argv3));
+    EXPECT_EQ(cli.wrong().front(), "[--versone] Unkonown argument (did you mean --verbose or --version?)");
+}
+
+TEST(ClipperCompletionTest, Candidates) {
+    std::string format;
+    int jobs;
+    bool verbose;
+
+    clipper cli("tool");
+    cli.help_flag("--help", "-h");
+    cli.add_flag("--verbose", "-v").set(verbose);
+    cli.add_option<std::string>("--format", "-f").set("fmt", format).match("json", "jsonl", "text");
+    cli.add_command("build", [&](clipper& cmd) {
+        cmd.add_option<int>("--jobs", "-j").set("n", jobs).match(1, 2, 4, 16);
+    });
+
+    auto complete = [&cli](std::vector<const char*> words) {
+        std::vector<std::string> found;
+        cli.complete(words, [&found](std::string_view w) { found.emplace_back(w); });
+        return found;
+    };
+    EXPECT_EQ(complete({ "--" }), (std::vector<std::string> { "--format", "--help", "--verbose" }));
+    EXPECT_EQ(complete({ "-v", "" }), (std::vector<std::string> { "--format", "--help", "--verbose", "-f", "-h", "-v", "build" }));
+    EXPECT_EQ(complete({ "b" }), (std::vector<std::string> { "build" }));
+    EXPECT_EQ(complete({ "--format", "js" }), (std::vector<std::string> { "json", "jsonl" }));
+    EXPECT_EQ(complete({ "-f", "" }), (std::vector<std::string> { "json", "jsonl", "text" }));
+    EXPECT_EQ(complete({ "--format=t" }), (std::vector<std::string> { "--format=text" }));
+    EXPECT_EQ(complete({ "--format", "text", "--v" }), (std::vector<std::string> { "--verbose" }));
+    EXPECT_EQ(complete({ "build", "--" }), (std::vector<std::string> { "--help", "--jobs" }));
+    EXPECT_EQ(complete({ "build", "-j", "1" }), (std::vector<std::string> { "1", "16" }));
+    EXPECT_TRUE(complete({ "--", "--v" }).empty());
+
+    std::FILE* out = std::tmpfile();
+    ASSERT_NE(out, nullptr);
+    const char* argv[] = { "tool", "__complete", "--format", "json", nullptr };
+    EXPECT_TRUE(cli.complete(4, argv, out));
+    std::rewind(out);
+    char text[32] = { };
+    EXPECT_EQ(std::fread(text, 1, sizeof(text) - 1, out), 11u);
+    EXPECT_STREQ(text, "json\njsonl\n");
+    std::fclose(out);
+
+    const char* argv2[] = { "tool", "--format", "json", nullptr };
+    EXPECT_FALSE(cli.complete(3, argv2));
+}
+
+TEST(ClipperCompletionTest, Scripts) {
+    clipper cli("my-tool");
+    EXPECT_NE(cli.completion_script(shell::bash).find("complete -o default -F _my_tool_complete my-tool"), std::string::npos);
+    EXPECT_NE(cli.completion_script(shell::zsh).find("compdef _my_tool my-tool"), std::string::npos);
+    EXPECT_NE(cli.completion_script(shell::fish).find("complete -c my-tool"), std::string::npos);
+    for (shell sh : { shell::bash, shell::zsh, shell::fish })
+        EXPECT_NE(cli.completion_script(sh).find("my-tool __complete"), std::string::npos);
+}
+
+TEST(ClipperPositionalTest, Positionals) {
+    std::filesystem::path input;
+    int level = 0;
+    bool verbose = false;
+    clipper cli("app");
+    cli.add_flag("--verbose", "-v").set(verbose);
+    cli.add_positional<std::filesystem::path>("input").set("input", input).doc("file to read").req();
+    cli.add_positional<int>("level").set("level", level).validate(rules::ibetween<-9, 9>);
+
+    const char* argv[] = { "app", "in.txt", "-v", "-3", nullptr };
+    ASSERT_TRUE(cli.parse(4, argv)) << cli.wrong().front();
+    EXPECT_EQ(input, "in.txt");
+    EXPECT_EQ(level, -3);
+    EXPECT_TRUE(verbose);
+    EXPECT_TRUE(cli.passthrough().empty());
+
+    parse_result res;
+    ASSERT_TRUE(std::as_const(cli).parse(4, argv, res));
+    EXPECT_EQ(res.get<int>("level"), -3);
+    EXPECT_EQ(res.value("input"), "in.txt");
+
+    const char* argv2[] = { "app", "-v", "in.txt", "10", "extra", nullptr };
+    cli.reset();
+    EXPECT_FALSE(cli.parse(5, argv2));
+    ASSERT_EQ(cli.wrong().size(), 2u);
+    EXPECT_EQ(cli.wrong()[0], "[level] Value 10 is not allowed \n\t{ <level>   [-9; 9] }");
+    EXPECT_EQ(cli.wrong()[1], "[extra] Unkonown argument");
+
+    const char* argv3[] = { "app", "-v", nullptr };
+    EXPECT_FALSE(cli.parse(2, argv3));
+    EXPECT_EQ(cli.wrong().front(), "[input] Missing required argument");
+
+    std::string help = cli.make_help();
+    EXPECT_NE(help.find("SYNOPSIS\n\tapp [...] <input> [<level>]\n"), std::string::npos);
+    EXPECT_NE(help.find("ARGUMENTS\n\t<input>"), std::string::npos);
+    EXPECT_EQ(help.find("OPTIONS"), std::string::npos);
+}
+
+TEST(ClipperPositionalTest, Passthrough) {
+    std::string tool;
+    bool verbose = false;
+    clipper cli("wrap");
+    cli.add_flag("-v").set(verbose);
+    cli.add_positional<std::string>("tool").set("tool", tool);
+
+    const char* argv[] = { "wrap", "-v", "gcc", "--", "-v", "--", "main.c", nullptr };
+    ASSERT_TRUE(cli.parse(7, argv));
+    EXPECT_EQ(tool, "gcc");
+    ASSERT_EQ(cli.passthrough().size(), 3u);
+    EXPECT_EQ(cli.passthrough().data(), argv + 4); // a view into argv
+    EXPECT_STREQ(cli.passthrough()[2], "main.c");
+
+    parse_result res;
+    ASSERT_TRUE(std::as_const(cli).parse(7, argv, res));
+    EXPECT_EQ(res.passthrough().data(), argv + 4);
+
+    const char* argv2[] = { "wrap", "--", nullptr };
+    ASSERT_TRUE(cli.parse(2, argv2));
+    EXPECT_TRUE(cli.passthrough().empty());
+
+    const char* argv3[] = { "wrap", "x", nullptr };
+    ASSERT_TRUE(cli.parse(2, argv3));
+    EXPECT_TRUE(cli.passthrough().empty()); // cleared
+}
+
+TEST(ClipperPositionalTest, UnknownOption) {
+    std::string file;
+    bool verbose = false;
+    clipper cli("app");
+    cli.add_flag("--verbose", "-v").set(verbose);
+    cli.add_positional<std::string>("file").set("file", file);
+
+    const char* argv[] = { "app", "--verbos", nullptr };
+    EXPECT_FALSE(cli.parse(2, argv));
+    ASSERT_EQ(cli.wrong().size(), 1u);
+    EXPECT_EQ(cli.wrong().front(), "[--verbos] Unkonown argument (did you mean --verbose?)");
+    EXPECT_TRUE(file.empty());
+
+    const char* argv2[] = { "app", "-vxq", nullptr };
+    EXPECT_FALSE(cli.parse(2, argv2));
+    EXPECT_EQ(cli.wrong().front(), "[-vxq] Unkonown argument");
+
+    parse_result res;
+    EXPECT_FALSE(std::as_const(cli).parse(2, argv, res));
+
+    const char* argv3[] = { "app", "-", nullptr };
+    ASSERT_TRUE(cli.parse(2, argv3));
+    EXPECT_EQ(file, "-");
+}
+
+TEST_F(ClipperTest, HelpCache) {
+    std::string_view text = cli.help_text();
+    EXPECT_EQ(cli.make_help(), text);
+    EXPECT_EQ(cli.help_text().data(), text.data()); // not created again
+    EXPECT_NE(text.find("\t-c, --count <>"), std::string_view::npos);
+
+    int extra;
+    cli.add_option<int>("--extra").set("n", extra);
+    EXPECT_NE(cli.help_text().find("--extra <n>"), std::string_view::npos);
+    cli.description("does things");
+    EXPECT_EQ(cli.help_text().substr(0, 25), "DESCRIPTION\n\tdoes things\n");
+
+    std::string full = cli.make_help();
+    char buffer[16];
+    EXPECT_EQ(cli.write_help(buffer, sizeof(buffer)), full.size());
+    EXPECT_EQ(std::string_view(buffer, sizeof(buffer)), std::string_view(full).substr(0, sizeof(buffer)));
+    EXPECT_EQ(cli.write_help(nullptr, 0), full.size()); // size query
+
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    EXPECT_TRUE(cli.write_help(file));
+    EXPECT_TRUE(cli.write_help(fileno(file)));
+    std::fflush(file);
+    std::rewind(file);
+    std::string written(full.size() * 2, '\0');
+    EXPECT_EQ(std::fread(written.data(), 1, written.size(), file), written.size());
+    EXPECT_EQ(written, full + full);
+    std::fclose(file);
+}
+
+TEST(ClipperStorageTest, StableReferences) {
+    std::vector<std::string> names;
+    for (int i = 0; i < 200; i++)
+        names.push_back("--opt" + std::to_string(i));
+
+    std::vector<int> values(names.size());
+    std::vector<option<int>*> opts;
+
+    clipper cli;
+    for (std::size_t i = 0; i < names.size(); i++)
+        opts.push_back(&cli.add_option<int>(names[i]).set("", values[i]));
+
+    for (std::size_t i = 0; i < names.size(); i++)
+        EXPECT_EQ(opts[i]->name, names[i]);
+
+    const char* argv[] = { "app", "--opt0", "1", "--opt199", "2", "--opt100", "3", nullptr };
+    EXPECT_NO_THROW({
+        ASSERT_TRUE(cli.parse(7, argv));
+    });
+    EXPECT_EQ(values[0], 1);
+    EXPECT_EQ(values[199], 2);
+    EXPECT_EQ(values[100], 3);
+}
+
+static constexpr static_schema test_schema {{
+    { "--input", "-i" },
+    { "--count", "-c" },
+    { "--flag", "-f" },
+    { "--name" }
+}};
+
+TEST(StaticSchemaTest, Lookup) {
+    static_assert(test_schema.size() == 4);
+    static_assert(test_schema.find("--input") == 0 && test_schema.find("-i") == 0);
+    static_assert(test_schema.find("--count") == 1 && test_schema.find("-c") == 1);
+    static_assert(test_schema.find("--flag") == 2 && test_schema.find("-f") == 2);
+    static_assert(test_schema.find("--name") == 3);
+    static_assert(test_schema.find("--unknown") == detail::npos);
+    static_assert(test_schema.find("") == detail::npos);
+}
+
+TEST(StaticSchemaTest, Parsing) {
+    std::string i_v, n_v;
+    int c_v;
+    bool f_v;
+
+    clipper cli("app", test_schema);
+    cli.add_option<std::string>("--input", "-i").set("", i_v).req();
+    cli.add_option<int>("--count", "-c").set("", c_v);
+    cli.add_flag("--flag", "-f").set(f_v);
+    cli.add_option<std::string>("--name").set("", n_v);
+
+    const char* argv[] = { "app", "-i", "in.txt", "--count", "5", "-f", "--name", "abc", nullptr };
+    EXPECT_NO_THROW({
+        ASSERT_TRUE(cli.parse(8, argv));
+    });
+    EXPECT_EQ(i_v, "in.txt");
+    EXPECT_EQ(c_v, 5);
+    EXPECT_TRUE(f_v);
+    EXPECT_EQ(n_v, "abc");
+
+    const char* argv2[] = { "app", "-i", "in.txt", "--unknown", nullptr };
+    EXPECT_NO_THROW({
+        EXPECT_FALSE(cli.parse(4, argv2));
+    });
+}
+
+TEST(StaticSchemaTest, UndeclaredOption) {
+    clipper cli(test_schema);
+    EXPECT_ANY_THROW(cli.add_option<int>("--count", "-c")); // out of order
+    EXPECT_NO_THROW(cli.add_option<std::string>("--input", "-i"));
+    EXPECT_ANY_THROW(cli.add_option<int>("--other"));
+}
+
+static constexpr static_schema help_schema {{
+    { "--input", "-i", "file", "File to read", true },
+    { "--count", "-c", "n", "Number of runs" },
+    { "--flag", "-f", { }, "Some flag" },
+    { "--name", { }, "name", "Name of the run" }
+}};
+
+static constexpr app_info help_info {
+    .name = "app",
+    .version = "1.2",
+    .author = "Author",
+    .license = "MIT",
+    .description = "Test application",
+    .help_flag = { "--help", "-h" },
+    .version_flag = { "--version", "-v" }
+};
+
+TEST(StaticSchemaTest, StaticHelp) {
+    using help = static_help<help_schema, help_info>;
+    static_assert(help::version_text() == "app 1.2\nAuthor\n");
+    static_assert(help::help_text().starts_with("DESCRIPTION\n\tTest application\n\nSYNOPSIS\n\tapp -i <file> [...]\n"));
+
+    std::string i_v, n_v;
+    int c_v;
+    bool f_v;
+
+    clipper cli("app", help_schema);
+    cli.version("1.2").author("Author").license("MIT").description("Test application");
+    cli.help_flag("--help", "-h");
+    cli.version_flag("--version", "-v");
+    cli.add_option<std::string>("--input", "-i").set("file", i_v).doc("File to read").req();
+    cli.add_option<int>("--count", "-c").set("n", c_v).doc("Number of runs");
+    cli.add_flag("--flag", "-f").set(f_v).doc("Some flag");
+    cli.add_option<std::string>("--name").set("name", n_v).doc("Name of the run");
+
+    EXPECT_EQ(help::help_text(), cli.make_help());
+    EXPECT_EQ(help::version_text(), cli.make_version_info());
+
+    cli.help_text(help::help_text());
+    EXPECT_EQ(cli.help_text().data(), help::help.data());
+    char buffer[8];
+    EXPECT_EQ(cli.write_help(buffer, sizeof(buffer)), help::help.size());
+
+    static constexpr app_info long_only {
+        .name = "app",
+        .help_flag = { "--help", { } },
+        .version_flag = { "--version", { } }
+    };
+    using long_help = static_help<help_schema, long_only>;
+    static_assert(long_help::help_text().find("\t--help ") != std::string_view::npos);
+
+    clipper cli2("app", help_schema);
+    cli2.help_flag("--help");
+    cli2.version_flag("--version");
+    cli2.add_option<std::string>("--input", "-i").set("file", i_v).doc("File to read").req();
+    cli2.add_option<int>("--count", "-c").set("n", c_v).doc("Number of runs");
+    cli2.add_flag("--flag", "-f").set(f_v).doc("Some flag");
+    cli2.add_option<std::string>("--name").set("name", n_v).doc("Name of the run");
+    EXPECT_EQ(long_help::help_text(), cli2.make_help());
+}
+
+TEST(ClipperVectorTest, RepeatedOptions) {
+    std::vector<std::filesystem::path> includes;
+    std::vector<unsigned> ids;
+    clipper cli("app");
+    cli.add_option<std::vector<std::filesystem::path>>("--include", "-I").set("dir", includes);
+    cli.add_option<std::vector<unsigned>>("--ids").set("id", ids).reserve(8).req();
+
+    const char* argv[] = { "app", "-I", "a", "--ids", "1,2,3", "--include", "b/c", "--ids", "4", nullptr };
+    ASSERT_TRUE(cli.parse(9, argv));
+    EXPECT_EQ(includes, (std::vector<std::filesystem::path> { "a", "b/c" }));
+    EXPECT_EQ(ids, (std::vector<unsigned> { 1, 2, 3, 4 }));
+
+    const char* argv2[] = { "app", "--ids", "1,-2", nullptr };
+    cli.reset();
+    EXPECT_FALSE(cli.parse(3, argv2));
+    EXPECT_TRUE(ids.empty());
+    EXPECT_EQ(cli.wrong().front(), "[--ids] Value 1,-2 is not allowed \n\t{ --ids <id>,...   }");
+
+    parse_result res;
+    EXPECT_TRUE(std::as_const(cli).parse(9, argv, res));
+    EXPECT_EQ(res.get<std::vector<unsigned>>("--ids"), (std::vector<unsigned> { 4 })); // last value
+    EXPECT_TRUE(ids.empty());
+}
+
+TEST_F(ClipperTest, AttachedValues) {
+    const char* argv[] = { "app", "--input=in.txt", "-o=out=put", "--count", "4", "-f", "--name=", "-l=9", nullptr };
+    ASSERT_TRUE(cli.parse(8, argv)) << ParsingWrong();
+    EXPECT_EQ(i_v, "in.txt");
+    EXPECT_EQ(o_v, "out=put");
+    EXPECT_EQ(c_v, 4);
+    EXPECT_EQ(n_v, "");
+    EXPECT_EQ(l_v, 9u);
+
+    parse_result res;
+    ASSERT_TRUE(std::as_const(cli).parse(8, argv, res));
+    EXPECT_EQ(res.value("--output"), "out=put");
+
+    const char* argv2[] = { "app", "-i", "x", "-o", "y", "-f", "-c=a", "-f=1", "--unknown=2", "=3", nullptr };
+    cli.reset();
+    EXPECT_FALSE(cli.parse(10, argv2));
+    ASSERT_EQ(cli.wrong().size(), 4u);
+    EXPECT_EQ(cli.wrong()[0], "[-c] Value a is not allowed \n\t{ -c, --count <>   }");
+    EXPECT_EQ(cli.wrong()[1], "[-f=1] Unkonown argument"); // flags do not take values
+    EXPECT_EQ(cli.wrong()[2], "[--unknown=2] Unkonown argument");
+    EXPECT_EQ(cli.wrong()[3], "[=3] Unkonown argument");
+}
+
+TEST_F(ClipperTest, ShortOptionClusters) {
+    const char* argv[] = { "app", "-fvs", "-ifile.txt", "-vo", "out", "-c12", "-l=3", "-hm2.5", nullptr };
+    ASSERT_TRUE(cli.parse(8, argv)) << ParsingWrong();
+    EXPECT_TRUE(f_v);
+    EXPECT_TRUE(v_v);
+    EXPECT_TRUE(s_v);
+    EXPECT_TRUE(h_v);
+    EXPECT_EQ(i_v, "file.txt");
+    EXPECT_EQ(o_v, "out");
+    EXPECT_EQ(c_v, 12);
+    EXPECT_EQ(l_v, 3u);
+    EXPECT_EQ(m_v, 2.5);
+
+    parse_result res;
+    ASSERT_TRUE(std::as_const(cli).parse(8, argv, res));
+    EXPECT_TRUE(res.is_set("--verbose"));
+    EXPECT_EQ(res.get<int>("-c"), 12);
+    EXPECT_EQ(res.value("--input"), "file.txt");
+
+    const char* argv2[] = { "app", "-i", "x", "-o", "y", "-fcx", "-fq", "--fv", "-fc", nullptr };
+    cli.reset();
+    EXPECT_FALSE(cli.parse(9, argv2));
+    ASSERT_EQ(cli.wrong().size(), 4u);
+    EXPECT_EQ(cli.wrong()[0], "[-c] Value x is not allowed \n\t{ -c, --count <>   }");
+    EXPECT_EQ(cli.wrong()[1], "[-fq] Unkonown argument");
+    EXPECT_EQ(cli.wrong()[2], "[--fv] Unkonown argument");
+    EXPECT_EQ(cli.wrong()[3], "[-fc] Missing option value");
+    EXPECT_FALSE(v_v); // nothing of an unknown cluster is set
+}
+
+TEST(ClipperAttachedTest, NamesWithEquals) {
+    std::string exact, split;
+    clipper cli("app");
+    cli.add_option<std::string>("--a=b").set("", exact);
+    cli.add_option<std::string>("--a").set("", split);
+
+    const char* argv[] = { "app", "--a=b", "1", "--a=c", nullptr };
+    ASSERT_TRUE(cli.parse(4, argv));
+    EXPECT_EQ(exact, "1");
+    EXPECT_EQ(split, "c");
+}
+
+class ResponseFileTest : public testing::Test {
+protected:
+    ResponseFileTest() {
+        cli.add_option<std::vector<std::string_view>>("--file", "-f").set("file", files);
+        cli.add_option<std::string>("--name", "-n").set("name", name);
+        cli.add_option<int>("--count", "-c").set("count", count);
+        cli.add_flag("--verbose", "-v").set(verbose);
+        cli.allow_response_files();
+    }
+
+    ~ResponseFileTest() {
+        for (const auto& p : paths)
+            std::filesystem::remove(p);
+    }
+
+    std::string write(std::string_view file_name, std::string_view contents) {
+        auto p = std::filesystem::temp_directory_path() / file_name;
+        std::ofstream(p, std::ios::binary) << contents;
+        paths.push_back(p);
+        return "@" + p.string();
+    }
+
+    std::vector<std::filesystem::path> paths;
+    std::vector<std::string_view> files;
+    std::string name;
+    int count;
+    bool verbose;
+    clipper cli;
+};
+
+TEST_F(ResponseFileTest, Expansion) {
+    std::string nested = write("clipper_nested.rsp", "-f nested.txt\n-c 3\n");
+    std::string rsp = write("clipper_args.rsp",
+        "-f a.txt\t-f \"with space.txt\"  -f 'single \\ quoted'\n"
+        "-f esc\\ aped -f \"q\\\"uote\" " + nested + "\r\n-n \"\"");
+
+    const char* argv[] = { "app", "-v", rsp.c_str(), "-f", "last.txt", nullptr };
+    ASSERT_TRUE(cli.parse(5, argv)) << cli.wrong().front();
+    EXPECT_TRUE(verbose);
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(name, "");
+    EXPECT_EQ(files, (std::vector<std::string_view> { "a.txt", "with space.txt", "single \\ quoted", "esc aped", "q\"uote", "nested.txt", "last.txt" }));
+}
+
+TEST_F(ResponseFileTest, Errors) {
+    std::string rsp = write("clipper_errors.rsp", "-c x @/nonexistent/clipper.rsp");
+    const char* argv[] = { "app", rsp.c_str(), "@", nullptr };
+    EXPECT_FALSE(cli.parse(3, argv));
+    ASSERT_EQ(cli.errors().size(), 3u);
+    EXPECT_EQ(cli.wrong()[0], "[@/nonexistent/clipper.rsp] Cannot read the response file"); // and left out
+    EXPECT_EQ(cli.wrong()[1], "[-c] Value x is not allowed \n\t{ -c, --count <count>   }");
+    EXPECT_EQ(cli.wrong()[2], "[@] Unkonown argument");
+    EXPECT_EQ(cli.errors()[0].kind, error_kind::response_file);
+
+    parse_result res;
+    EXPECT_FALSE(std::as_const(cli).parse(3, argv, res));
+    ASSERT_EQ(res.errors().size(), 3u);
+    EXPECT_EQ(res.format_error(res.errors()[0]), "[@/nonexistent/clipper.rsp] Cannot read the response file");
+
+    std::string cycle = write("clipper_cycle.rsp", "-v ");
+    std::ofstream(paths.back(), std::ios::app) << cycle;
+    const char* argv2[] = { "app", cycle.c_str(), nullptr };
+    EXPECT_FALSE(cli.parse(2, argv2)); // nesting limit
+    ASSERT_EQ(cli.errors().size(), 1u);
+    EXPECT_EQ(cli.errors()[0].kind, error_kind::response_file);
+    EXPECT_TRUE(verbose);
+}
+
+TEST_F(ResponseFileTest, LongArguments) {
+    std::vector<std::string> expected;
+    std::string contents;
+    for (std::size_t len : { 1, 15, 16, 17, 31, 32, 33, 64, 100 }) {
+        std::string plain(len, 'p'), quoted(len, 'q');
+        quoted[len / 2] = ' ';
+        contents += "-f " + plain + " -f \"" + quoted + "\"\t-f " + plain + "\\ " + plain + "\n";
+        expected.insert(expected.end(), { plain, quoted, plain + ' ' + plain });
+    }
+
+    std::string rsp = write("clipper_long.rsp", contents);
+    const char* argv[] = { "app", rsp.c_str(), nullptr };
+    ASSERT_TRUE(cli.parse(2, argv)) << cli.wrong().front();
+    EXPECT_EQ(std::vector<std::string>(files.begin(), files.end()), expected);
+}
+
+TEST(ResponseScannerTest, MatchesScalar) {
+    const char alphabet[] = "ab=-_ \t\n\r\v\f\"'\\\x08\x0e\x1f\x7f\x80\xff";
+    std::string buf(300, 'a');
+    unsigned state = 1;
+    for (char& c : buf) {
+        state = state * 1103515245u + 12345u;
+        c = (state >> 16) % 4 == 0 ? alphabet[(state >> 8) % (sizeof(alphabet) - 1)] : 'x';
+    }
+
+    for (std::size_t begin = 0; begin < 40; begin++)
+        for (std::size_t end = begin; end <= buf.size(); end += 7) {
+            const char* b = buf.data() + begin;
+            const char* e = buf.data() + end;
+            ASSERT_EQ(detail::find_response_special(b, e), detail::find_response_special_scalar(b, e)) << begin << ' ' << end;
+        }
+
+    std::string plain(100, 'x');
+    EXPECT_EQ(detail::find_response_special(plain.data(), plain.data() + plain.size()), plain.data() + plain.size());
+}
+
+TEST_F(ResponseFileTest, Passthrough) {
+    std::string rsp = write("clipper_passthrough.rsp", "-c 2");
+    const char* argv[] = { "app", rsp.c_str(), "--", rsp.c_str(), "-v", nullptr };
+    ASSERT_TRUE(cli.parse(5, argv));
+    EXPECT_EQ(count, 2);
+    EXPECT_FALSE(verbose);
+    ASSERT_EQ(cli.passthrough().size(), 2u);
+    EXPECT_EQ(cli.passthrough().data(), argv + 3); // not expanded
+
+    std::string inner = write("clipper_inner.rsp", "-c 3 -- -v");
+    const char* argv2[] = { "app", inner.c_str(), nullptr };
+    EXPECT_FALSE(cli.parse(2, argv2)); // not in argv
+    EXPECT_EQ(cli.wrong().front(), "[--] Unkonown argument");
+}
+
+TEST_F(ResponseFileTest, ParseResult) {
+    std::string rsp = write("clipper_result.rsp", "-n \"my name\" -c 12");
+    const char* argv[] = { "app", rsp.c_str(), nullptr };
+
+    parse_result res;
+    ASSERT_TRUE(std::as_const(cli).parse(2, argv, res));
+    EXPECT_EQ(res.value("-n"), "my name");
+    EXPECT_EQ(res.get<int>("-c"), 12);
+    EXPECT_EQ(name, "");
+
+    clipper plain;
+    plain.add_option<std::string>("-n").set("name", name);
+    EXPECT_FALSE(plain.parse(2, argv)); // not enabled
+}
+
+class ClipperLayerTest : public testing::Test {
+protected:
+    ClipperLayerTest() {
+        cli.add_option<std::string>("--name", "-n").set("name", name);
+        cli.add_option<int>("--max-count", "-c").set("n", count).match(1, 2, 3, 10);
+        cli.add_option<std::string_view>("--format").set("fmt", format);
+        cli.add_flag("--verbose", "-v").set(verbose);
+        cli.allow_no_args();
+        cli.env_prefix("CLIPPER_TEST_");
+        path = std::filesystem::temp_directory_path() / "clipper_layers.ini";
+        cli.config_file(path.string());
+    }
+
+    ~ClipperLayerTest() {
+        std::filesystem::remove(path);
+        for (const char* var : { "CLIPPER_TEST_NAME", "CLIPPER_TEST_MAX_COUNT", "CLIPPER_TEST_VERBOSE", "CLIPPER_TEST_FORMAT" })
+            ::unsetenv(var);
+    }
+
+    void write(std::string_view contents) {
+        std::ofstream(path, std::ios::binary) << contents;
+    }
+
+    std::filesystem::path path;
+    std::string name;
+    int count = 0;
+    std::string_view format;
+    bool verbose = false;
+    clipper cli { "app" };
+};
+
+TEST_F(ClipperLayerTest, Precedence) {
+    write("# defaults\n[app]\nname = \"from file\"\nmax-count = 2 ; comment\nformat=json\n\nverbose = on\n");
+    ::setenv("CLIPPER_TEST_MAX_COUNT", "3", 1);
+    ::setenv("CLIPPER_TEST_OTHER", "x", 1);
+
+    const char* argv[] = { "app", "-n", "arg", nullptr };
+    ASSERT_TRUE(cli.parse(3, argv)) << cli.wrong().front();
+    EXPECT_EQ(name, "arg");   // arguments first
+    EXPECT_EQ(count, 3);      // then the environment
+    EXPECT_EQ(format, "json"); // then the file (a view into it)
+    EXPECT_TRUE(verbose);
+
+    ::setenv("CLIPPER_TEST_VERBOSE", "false", 1);
+    cli.reset();
+    ASSERT_TRUE(cli.parse(1, argv));
+    EXPECT_EQ(name, "from file");
+    EXPECT_FALSE(verbose);
+}
+
+TEST_F(ClipperLayerTest, Errors) {
+    write("name = a\nmax-count = 5\nunknown = 1\nbroken line\n");
+    ::setenv("CLIPPER_TEST_VERBOSE", "maybe", 1);
+    ::setenv("CLIPPER_TEST_FORMAT", "text", 1);
+
+    const char* argv[] = { "app", nullptr };
+    EXPECT_FALSE(cli.parse(1, argv));
+    ASSERT_EQ(cli.wrong().size(), 4u);
+    const std::string file = path.string();
+    EXPECT_EQ(std::string_view(cli.wrong()[0]), "[" + file + ":3] Unkonown option unknown");
+    EXPECT_EQ(std::string_view(cli.wrong()[1]), "[" + file + ":4] Expected name = value");
+    EXPECT_EQ(std::string_view(cli.wrong()[2]), "[" + file + ":2 max-count] Value 5 is not allowed \n\t{ -c, --max-count (1 2 3 10)   } (did you mean 1, 2 or 3?)");
+    EXPECT_EQ(cli.wrong()[3], "[CLIPPER_TEST_VERBOSE] Value maybe is not allowed \n\t{ -v, --verbose    }");
+    EXPECT_EQ(format, "text");
+    EXPECT_EQ(name, "a");
+
+    std::filesystem::remove(path); // a missing file is not an error
+    ::unsetenv("CLIPPER_TEST_VERBOSE");
+    cli.reset();
+    EXPECT_TRUE(cli.parse(1, argv));
+    EXPECT_TRUE(name.empty());
+}
+
+struct struct_config {
+    std::string input;
+    int jobs = 1;
+    double ratio = 0.5;
+    bool verbose = false;
+    std::vector<std::string_view> defines;
+};
+
+static constexpr std::tuple struct_fields {
+    field { "--input", "-i", &struct_config::input, "File to read" }.req(),
+    field { "--jobs", "-j", &struct_config::jobs, "Number of jobs", pred::between<1, 64> },
+    field { "--ratio", &struct_config::ratio },
+    field { "--verbose", "-v", &struct_config::verbose, "Verbose output" },
+    field { "--define", "-D", &struct_config::defines }
+};
+
+TEST(StructParserTest, Parsing) {
+    using parser = struct_parser<struct_fields>;
+    static_assert(parser::size == 5);
+    static_assert(parser::schema.find("-j") == 1 && parser::schema.find("--define") == 4);
+    static_assert(parser::schema[3].value.empty() && parser::schema[0].required);
+    static_assert(static_help<parser::schema, help_info>::help_text().find("\t-i, --input <value>   File to read\n") != std::string_view::npos);
+
+    struct_config cfg;
+    const char* argv[] = { "app", "-i", "in.txt", "--jobs=8", "-v", "-D", "A", "--define", "B=1", "--ratio", "0.25", nullptr };
+    std::pmr::vector<parse_error> errors;
+    ASSERT_TRUE(parser::parse(11, argv, cfg, &errors));
+    EXPECT_TRUE(errors.empty());
+    EXPECT_EQ(cfg.input, "in.txt");
+    EXPECT_EQ(cfg.jobs, 8);
+    EXPECT_DOUBLE_EQ(cfg.ratio, 0.25);
+    EXPECT_TRUE(cfg.verbose);
+    EXPECT_EQ(cfg.defines, (std::vector<std::string_view> { "A", "B=1" }));
+
+    struct_config def;
+    const char* argv2[] = { "app", "-i", "x", nullptr };
+    ASSERT_TRUE(parser::parse(3, argv2, def)); // without collecting the errors
+    EXPECT_EQ(def.jobs, 1);
+    EXPECT_FALSE(def.verbose);
+}
+
+TEST(StructParserTest, Errors) {
+    using parser = struct_parser<struct_fields>;
+    struct_config cfg;
+    const char* argv[] = { "app", "-j", "100", "--ratio=abc", "-v=1", "--unknown", "--jobs", nullptr };
+    std::pmr::vector<parse_error> errors;
+    ASSERT_FALSE(parser::parse(7, argv, cfg, &errors));
+    ASSERT_EQ(errors.size(), 6u);
+    EXPECT_EQ(parser::format_error(errors[0], 7, argv), "[-j] Value 100 is not allowed \n\t{ -j, --jobs <value>  Number of jobs }");
+    EXPECT_EQ(errors[1].kind, error_kind::invalid_value);
+    EXPECT_EQ(parser::format_error(errors[1], 7, argv), "[--ratio] Value abc is not allowed \n\t{ --ratio <value>   }");
+    EXPECT_EQ(parser::format_error(errors[2], 7, argv), "[-v=1] Unkonown argument"); // flags do not take values
+    EXPECT_EQ(parser::format_error(errors[3], 7, argv), "[--unknown] Unkonown argument");
+    EXPECT_EQ(parser::format_error(errors[4], 7, argv), "[--jobs] Missing option value");
+    EXPECT_EQ(parser::format_error(errors[5], 7, argv), "[-i] Missing required argument");
+    EXPECT_EQ(cfg.jobs, 1); // not assigned
+    EXPECT_FALSE(parser::parse(7, argv, cfg));
+
+    const char* argv2[] = { "app", nullptr };
+    errors.clear();
+    EXPECT_FALSE(parser::parse(1, argv2, cfg, &errors));
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(parser::format_error(errors[0], 1, argv2), "[-i] Missing required argument");
+}
@@ -0,0 +1,118 @@
+// Built with CLIPPER_INSTRUMENT=1, see CMakeLists.txt
+#include <gtest/gtest.h>
+#include "clipper.hpp"
+using namespace CLI;
+
+static_assert(CLIPPER_INSTRUMENT == 1, "This test has to be built with the instrumentation enabled");
+
+struct recorder : parse_observer {
+    std::vector<std::pair<std::string, bool>> lookups;
+    std::vector<std::pair<std::string, assign_status>> conversions;
+    std::vector<parse_phase> phases;
+
+    void lookup(std::string_view name, bool found) override
+    { lookups.emplace_back(name, found); }
+
+    void conversion(std::string_view option, assign_status status) override
+    { conversions.emplace_back(option, status); }
+
+    void phase(parse_phase ph, std::chrono::nanoseconds time) override {
+        EXPECT_GE(time.count(), 0);
+        phases.push_back(ph);
+    }
+};
+
+TEST(InstrumentTest, Events) {
+    int count;
+    bool verbose;
+    recorder rec;
+
+    clipper cli("app");
+    cli.observe(&rec);
+    cli.allow_response_files();
+    cli.add_option<int>("--count", "-c").set("n", count).match(1, 2, 3);
+    cli.add_flag("--verbose", "-v").set(verbose);
+
+    const char* argv[] = { "app", "-c", "x", "--unknown", "-v", "--count=2", nullptr };
+    EXPECT_FALSE(cli.parse(6, argv));
+    EXPECT_EQ(rec.lookups, (std::vector<std::pair<std::string, bool>> {
+        { "-c", true }, { "--unknown", false }, { "-v", true }, { "--count=2", false } // the attached form is looked up again
+    }));
+    EXPECT_EQ(rec.conversions, (std::vector<std::pair<std::string, assign_status>> {
+        { "--count", assign_status::invalid_value }, { "--verbose", assign_status::ok }, { "--count", assign_status::ok }
+    }));
+    EXPECT_EQ(rec.phases, (std::vector<parse_phase> { parse_phase::expand, parse_phase::scan, parse_phase::check }));
+
+    rec = { };
+    parse_result res;
+    const char* argv2[] = { "app", "-c", "4", nullptr };
+    EXPECT_FALSE(cli.parse(3, argv2, res));
+    EXPECT_EQ(rec.conversions, (std::vector<std::pair<std::string, assign_status>> { { "--count", assign_status::not_allowed } }));
+    EXPECT_EQ(rec.phases, (std::vector<parse_phase> { parse_phase::expand, parse_phase::scan, parse_phase::check }));
+
+    rec = { };
+    cli.observe(nullptr);
+    const char* argv3[] = { "app", "-c", "1", nullptr };
+    EXPECT_TRUE(cli.parse(3, argv3));
+    EXPECT_TRUE(rec.lookups.empty());
+}
+
+TEST(InstrumentTest, StatsJson) {
+    parse_stats stats;
+    int count;
+    bool verbose;
+    {
+        clipper cli("app", &stats);
+        cli.observe(&stats);
+        cli.allow_response_files();
+        cli.add_option<int>("--count", "-c").set("n", count).match(1, 2, 3);
+        cli.add_flag("--verbose", "-v").set(verbose);
+
+        const char* argv[] = { "app", "-c", "7", "--unknown", "-v", nullptr };
+        EXPECT_FALSE(cli.parse(5, argv));
+        EXPECT_FALSE(cli.wrong().empty());
+    }
+
+    EXPECT_EQ(stats.lookups, 3u);
+    EXPECT_EQ(stats.unknown, 1u);
+    EXPECT_EQ(stats.conversions, 2u);
+    EXPECT_EQ(stats.not_allowed, 1u);
+    EXPECT_EQ(stats.invalid_values, 0u);
+    EXPECT_GT(stats.allocations, 0u);
+    EXPECT_EQ(stats.phase_count[0], 1u);
+    EXPECT_EQ(stats.phase_count[1], 1u);
+    EXPECT_EQ(stats.phase_count[2], 1u);
+
+    std::string json = stats.json();
+    EXPECT_EQ(json.rfind("{\"lookups\":3,\"unknown\":1,\"conversions\":2,\"invalid_values\":0,\"not_allowed\":1,\"allocations\":", 0), 0u);
+    EXPECT_NE(json.find(",\"phases\":{\"expand\":{\"count\":1,\"ns\":"), std::string::npos);
+    EXPECT_NE(json.find("},\"scan\":{\"count\":1,\"ns\":"), std::string::npos);
+    EXPECT_EQ(json.substr(json.size() - 2), "}}");
+
+    stats.reset();
+    EXPECT_EQ(stats.json().rfind("{\"lookups\":0,\"unknown\":0,\"conversions\":0,\"invalid_values\":0,\"not_allowed\":0,\"allocations\":0,\"allocated_bytes\":0,"
+        "\"phases\":{\"expand\":{\"count\":0,\"ns\":0},\"scan\":{\"count\":0,\"ns\":0},\"check\":{\"count\":0,\"ns\":0}}}", 0), 0u);
+}
+
+TEST(InstrumentTest, BatchAndCommands) {
+    parse_stats stats;
+    int count;
+    bool release;
+    clipper cli("app");
+    cli.observe(&stats);
+    cli.add_option<int>("--count", "-c").set("n", count);
+    cli.add_command("build", [&release](clipper& cmd) { cmd.add_flag("--release").set(release); });
+
+    batch_result res;
+    EXPECT_TRUE(cli.parse_batch("-c 1\n-c 2\n-c 3\n", res, 2));
+    EXPECT_EQ(stats.lookups, 3u);
+    EXPECT_EQ(stats.conversions, 3u);
+    EXPECT_EQ(stats.phase_count[1], 0u); // no phases for batches
+
+    stats.reset();
+    const char* argv[] = { "app", "build", "--release", nullptr };
+    EXPECT_TRUE(cli.parse(3, argv));
+    EXPECT_EQ(stats.lookups, 2u); // the command name and the option of the command
+    EXPECT_EQ(stats.phase_count[0], 0u); // response files are not allowed
+    EXPECT_EQ(stats.phase_count[1], 2u);
+}
@@ -0,0 +1,50 @@
+// Built with -fno-exceptions, see CMakeLists.txt
+#include <gtest/gtest.h>
+#include "clipper.hpp"
+using namespace CLI;
+
+static_assert(CLIPPER_EXCEPTIONS == 0, "This test has to be built with exceptions disabled");
+
+TEST(NoExceptionsTest, TryAssign) {
+    int num_v;
+    option<int> num("-n");
+    num.set("number", num_v).match(1, 2, 3);
+
+    EXPECT_EQ(num.try_assign("2"), assign_status::ok);
+    EXPECT_EQ(num_v, 2);
+    EXPECT_EQ(num.try_assign("abc"), assign_status::invalid_value);
+    EXPECT_EQ(num.try_assign("5000000000"), assign_status::invalid_value);
+    EXPECT_EQ(num.try_assign("4"), assign_status::not_allowed);
+    EXPECT_EQ(num_v, 2);
+
+    char ch_v;
+    option<char> ch("-c");
+    ch.set("char", ch_v);
+    EXPECT_EQ(ch.try_assign(""), assign_status::invalid_value);
+    EXPECT_EQ(ch.try_assign("x"), assign_status::ok);
+    EXPECT_EQ(ch_v, 'x');
+}
+
+TEST(NoExceptionsTest, Parsing) {
+    int c_v;
+    std::string s_v;
+    bool f_v;
+
+    clipper cli;
+    cli.add_option<int>("--count", "-c").set("number", c_v).match(1, 2, 3).req();
+    cli.add_option<std::string>("--str", "-s").set("string", s_v);
+    cli.add_flag("--flag", "-f").set(f_v);
+
+    const char* argv[] = { "app", "-c", "3", "-s", "abc", "-f", nullptr };
+    ASSERT_TRUE(cli.parse(6, argv));
+    EXPECT_EQ(c_v, 3);
+    EXPECT_EQ(s_v, "abc");
+    EXPECT_TRUE(f_v);
+
+    clipper cli2;
+    cli2.add_option<int>("--count", "-c").set("number", c_v).match(1, 2, 3).req();
+
+    const char* argv2[] = { "app", "-c", "7", "-c", "x", "--unknown", nullptr };
+    EXPECT_FALSE(cli2.parse(6, argv2));
+    EXPECT_EQ(cli2.wrong().size(), 3u);
+}
@@ -216,4 +216,271 @@ TEST_F(OptionTest, ValuePredicateValidation) {
     EXPECT_NO_THROW(str = "abc"sv;); EXPECT_EQ(str_v, "abc");
     EXPECT_ANY_THROW(str = "mystring"s;);
     EXPECT_ANY_THROW(str = "abecadło"sv;);
-}
\ No newline at end of file
+}
+
+
+TEST_F(OptionTest, Reset) {
+    using namespace std::string_view_literals;
+    num = "10";
+    str = "abecadło"sv;
+    flag = "";
+    EXPECT_TRUE(num.is_set());
+
+    num.reset();
+    str.reset();
+    flag.reset();
+    path.reset();
+
+    EXPECT_FALSE(num.is_set());
+    EXPECT_FALSE(str.is_set());
+    EXPECT_EQ(num_v, 11);
+    EXPECT_EQ(str_v, "mystring");
+    EXPECT_EQ(path_v, "mypath.txt");
+    EXPECT_FALSE(flag_v);
+}
+
+TEST_F(OptionTest, LargeMatchList) {
+    for (int i = 2000; i > 0; i -= 2) // out of order, crosses the threshold on the way
+        num.match(i);
+    num.match(1, 3, 5);
+
+    EXPECT_NO_THROW(num = "2000";); EXPECT_EQ(num_v, 2000);
+    EXPECT_NO_THROW(num = "2";);    EXPECT_EQ(num_v, 2);
+    EXPECT_NO_THROW(num = "5";);    EXPECT_EQ(num_v, 5);
+    EXPECT_NO_THROW(num = "1000";); EXPECT_EQ(num_v, 1000);
+    EXPECT_ANY_THROW(num = "7";);
+    EXPECT_ANY_THROW(num = "2002";);
+    EXPECT_ANY_THROW(num = "0";);
+    EXPECT_EQ(num.value_info().substr(0, 15), "(2000 1998 1996"); // declaration order
+
+    std::vector<std::string> regions;
+    for (int i = 0; i < 100; i++)
+        regions.push_back("region-" + std::to_string(i));
+    for (const auto& r : regions)
+        str.match(r);
+
+    EXPECT_NO_THROW(str = std::string("region-42");); EXPECT_EQ(str_v, "region-42");
+    EXPECT_NO_THROW(str = std::string("region-0"););  EXPECT_EQ(str_v, "region-0");
+    EXPECT_ANY_THROW(str = std::string("region-100"););
+    EXPECT_ANY_THROW(str = std::string("region"););
+}
+
+TEST_F(OptionTest, ValueRuleValidation) {
+    num.doc("Number").validate(rules::ibetween<1, 64> && rules::even);
+    EXPECT_EQ(num.doc(), "Number [1; 64] and even");
+    EXPECT_NO_THROW(num = "2";);  EXPECT_EQ(num_v, 2);
+    EXPECT_NO_THROW(num = "64";); EXPECT_EQ(num_v, 64);
+    EXPECT_ANY_THROW(num = "3";);
+    EXPECT_ANY_THROW(num = "66";);
+
+    num.require("not 32", [](const int& v) { return v != 32; }); // every predicate has to be met
+    EXPECT_NO_THROW(num = "30";); EXPECT_EQ(num_v, 30);
+    EXPECT_ANY_THROW(num = "32";);
+    EXPECT_EQ(num.doc(), "Number [1; 64] and even not 32");
+
+    unsigned un_v;
+    option<unsigned> un("-u");
+    un.set("n", un_v).validate("small", rules::iless_than<100>);
+    EXPECT_EQ(un.try_assign("100"), assign_status::ok);
+    EXPECT_EQ(un.try_assign("101"), assign_status::not_allowed);
+    EXPECT_EQ(un.doc(), " small");
+
+    str.validate(rules::make("lower case", [](const std::string& s) { return s.find_first_not_of("abcdefghijklmnopqrstuvwxyz") == s.npos; }));
+    EXPECT_NO_THROW(str = std::string("abc"););
+    EXPECT_ANY_THROW(str = std::string("aBc"););
+}
+
+TEST(OptionViewTest, StringView) {
+    std::string_view view_v;
+    option<std::string_view> view("--view", "-v");
+    view.set("string", view_v, "default").match("abc", std::string("a longer string that is allowed too"));
+    EXPECT_EQ(view_v, "default");
+    EXPECT_EQ(view.value_info(), "(abc a longer string that is allowed too)");
+
+    std::string arg = "a longer string that is allowed too";
+    EXPECT_EQ(view.try_assign(arg), assign_status::ok);
+    EXPECT_EQ(view_v.data(), arg.data()); // refers to the argument
+
+    EXPECT_EQ(view.try_assign("abcd"), assign_status::not_allowed);
+    view.reset();
+    EXPECT_EQ(view_v, "default");
+
+    path_view path_v;
+    option<path_view> path("--path");
+    path.set("file", path_v);
+    const char* file = "/usr/share/clipper/a.txt";
+    EXPECT_EQ(path.try_assign(file), assign_status::ok);
+    EXPECT_EQ(path_v.data(), file);
+    EXPECT_EQ(std::filesystem::path(path_v).filename(), "a.txt");
+}
+
+TEST(OptionVectorTest, Lists) {
+    std::vector<int> ids_v;
+    option<std::vector<int>> ids("--ids");
+    ids.set("id", ids_v).validate(rules::igreater_than<0>);
+    EXPECT_EQ(ids.value_info(), "<id>,...");
+    EXPECT_EQ(ids.doc(), " >= 0");
+
+    EXPECT_EQ(ids.try_assign("1,2,3"), assign_status::ok);
+    EXPECT_EQ(ids.try_assign("42"), assign_status::ok); // appends
+    EXPECT_EQ(ids_v, (std::vector<int> { 1, 2, 3, 42 }));
+
+    EXPECT_EQ(ids.try_assign("5,x,6"), assign_status::invalid_value);
+    EXPECT_EQ(ids.try_assign("5,6,"), assign_status::invalid_value);
+    EXPECT_EQ(ids.try_assign("5;6"), assign_status::invalid_value);
+    EXPECT_EQ(ids.try_assign("5,-6"), assign_status::not_allowed);
+    EXPECT_EQ(ids_v.size(), 4u); // nothing appended on failure
+    EXPECT_EQ(ids.check("7,8"), assign_status::ok);
+    EXPECT_EQ(ids.check("7,-8"), assign_status::not_allowed);
+    EXPECT_EQ(ids_v.size(), 4u);
+
+    ids.reset();
+    EXPECT_TRUE(ids_v.empty());
+    EXPECT_FALSE(ids.is_set());
+
+    ids.delimiter(':');
+    EXPECT_EQ(ids.try_assign("7:8"), assign_status::ok);
+    EXPECT_EQ(ids_v, (std::vector<int> { 7, 8 }));
+    EXPECT_EQ(ids.value_info(), "<id>:...");
+
+    std::vector<std::string> dirs_v;
+    option<std::vector<std::string>> dirs("--include", "-I");
+    dirs.set("dir", dirs_v).match("a,b", "c", "d");
+    EXPECT_EQ(dirs.value_info(), "(a,b c d)...");
+    EXPECT_EQ(dirs.try_assign("a,b"), assign_status::ok); // no delimiter for strings by default
+    EXPECT_EQ(dirs.try_assign("e"), assign_status::not_allowed);
+    dirs.delimiter(',');
+    EXPECT_EQ(dirs.try_assign("c,d"), assign_status::ok);
+    EXPECT_EQ(dirs.try_assign("c,a,b"), assign_status::not_allowed);
+    EXPECT_EQ(dirs_v, (std::vector<std::string> { "a,b", "c", "d" }));
+
+    std::vector<double> dbl_v;
+    option<std::vector<double>> dbl("-d");
+    dbl.set("value", dbl_v).reserve(16);
+    EXPECT_GE(dbl_v.capacity(), 16u);
+    EXPECT_EQ(dbl.try_assign("0.5,1e3,-2"), assign_status::ok);
+    EXPECT_EQ(dbl_v, (std::vector<double> { 0.5, 1e3, -2 }));
+}
+
+TEST(OptionUnitTest, Durations) {
+    std::chrono::milliseconds ms_v;
+    option<std::chrono::milliseconds> ms("--timeout", "-t");
+    ms.set("time", ms_v);
+    EXPECT_EQ(ms.try_assign("250ms"), assign_status::ok);
+    EXPECT_EQ(ms_v.count(), 250);
+    EXPECT_EQ(ms.try_assign("2min"), assign_status::ok);
+    EXPECT_EQ(ms_v.count(), 120000);
+    EXPECT_EQ(ms.try_assign("1d"), assign_status::ok);
+    EXPECT_EQ(ms_v.count(), 86400000);
+    EXPECT_EQ(ms.try_assign("30"), assign_status::ok); // the duration period
+    EXPECT_EQ(ms_v.count(), 30);
+    EXPECT_EQ(ms.try_assign("3000us"), assign_status::ok);
+    EXPECT_EQ(ms_v.count(), 3);
+
+    EXPECT_EQ(ms.try_assign("1500us"), assign_status::invalid_value); // not a whole number of milliseconds
+    EXPECT_EQ(ms.try_assign("1.5s"), assign_status::invalid_value);
+    EXPECT_EQ(ms.try_assign("5 s"), assign_status::invalid_value);
+    EXPECT_EQ(ms.try_assign("5y"), assign_status::invalid_value);
+    EXPECT_EQ(ms.try_assign("ms"), assign_status::invalid_value);
+    EXPECT_EQ(ms.try_assign("99999999999999999d"), assign_status::invalid_value);
+    EXPECT_EQ(ms_v.count(), 3);
+
+    std::chrono::duration<double> sec_v;
+    option<std::chrono::duration<double>> sec("-s");
+    sec.set("time", sec_v);
+    EXPECT_EQ(sec.try_assign("1.5ms"), assign_status::ok);
+    EXPECT_DOUBLE_EQ(sec_v.count(), 0.0015);
+
+    std::chrono::duration<std::uint16_t> small_v;
+    option<std::chrono::duration<std::uint16_t>> small("-w");
+    small.set("time", small_v);
+    EXPECT_EQ(small.try_assign("1h"), assign_status::ok);
+    EXPECT_EQ(small.try_assign("1d"), assign_status::invalid_value); // does not fit the count type
+    EXPECT_EQ(small.try_assign("-1s"), assign_status::invalid_value);
+
+    ms.match(std::chrono::milliseconds(250), std::chrono::seconds(1)).require("", [](const std::chrono::milliseconds& v) { return v.count() > 0; });
+    EXPECT_EQ(ms.value_info(), "(250ms 1000ms)");
+    EXPECT_EQ(ms.try_assign("1s"), assign_status::ok);
+    EXPECT_EQ(ms.try_assign("2s"), assign_status::not_allowed);
+
+    std::vector<std::chrono::seconds> at_v;
+    option<std::vector<std::chrono::seconds>> at("--at");
+    at.set("time", at_v);
+    EXPECT_EQ(at.try_assign("1m,2h,30"), assign_status::ok);
+    EXPECT_EQ(at_v, (std::vector<std::chrono::seconds> { std::chrono::seconds(60), std::chrono::seconds(7200), std::chrono::seconds(30) }));
+}
+
+TEST(OptionUnitTest, ByteSizes) {
+    byte_size size_v;
+    option<byte_size> size("--cache");
+    size.set("size", size_v, byte_size { 1024 });
+    EXPECT_EQ(size_v.bytes, 1024u);
+
+    const std::pair<const char*, std::uint64_t> valid[] = {
+        { "0", 0 }, { "512", 512 }, { "512B", 512 }, { "4K", 4096 }, { "4k", 4096 }, { "4KiB", 4096 }, { "4kB", 4000 },
+        { "4KB", 4000 }, { "3M", 3u << 20 }, { "3MB", 3000000 }, { "4GiB", 4ull << 30 }, { "2T", 2ull << 40 }, { "16EiB", 0 }
+    };
+    for (const auto& [text, bytes] : valid) {
+        if (bytes == 0 and text[0] != '0') {
+            EXPECT_EQ(size.try_assign(text), assign_status::invalid_value) << text; // does not fit 64 bits
+            continue;
+        }
+        EXPECT_EQ(size.try_assign(text), assign_status::ok) << text;
+        EXPECT_EQ(size_v.bytes, bytes) << text;
+    }
+
+    for (const char* text : { "", "K", "4X", "4KiBs", "4Ki", "4iB", "-4K", "4 K", "4b" })
+        EXPECT_EQ(size.try_assign(text), assign_status::invalid_value) << text;
+
+    size.match(byte_size { 4096 }, byte_size { 3000000 }, byte_size { 100 });
+    EXPECT_EQ(size.value_info(), "(4KiB 3MB 100)");
+    EXPECT_EQ(size.try_assign("4K"), assign_status::ok);
+    EXPECT_EQ(size.try_assign("3000kB"), assign_status::ok);
+    EXPECT_EQ(size.try_assign("4M"), assign_status::not_allowed);
+}
+
+enum class test_mode { fast, safe, slow };
+
+template<>
+struct CLI::enum_names<test_mode> {
+    static constexpr enum_table<test_mode, 4> table {{
+        { "fast", test_mode::fast }, { "safe", test_mode::safe }, { "slow", test_mode::slow }, { "quick", test_mode::fast }
+    }};
+};
+
+TEST(OptionEnumTest, Names) {
+    constexpr const auto& table = enum_names<test_mode>::table;
+    static_assert(is_named_enum<test_mode> and option_types<test_mode> and option_types<std::vector<test_mode>>);
+    static_assert(table.name(test_mode::fast) == "fast" and table.name(test_mode::slow) == "slow");
+    static_assert([] { test_mode m { }; return table.find("quick", m) and m == test_mode::fast; }());
+    static_assert([] { test_mode m { }; return not table.find("Fast", m) and not table.find("", m); }());
+
+    test_mode mode_v;
+    option<test_mode> mode("--mode", "-m");
+    mode.set("mode", mode_v, test_mode::safe);
+    EXPECT_EQ(mode_v, test_mode::safe);
+    EXPECT_EQ(mode.try_assign("slow"), assign_status::ok);
+    EXPECT_EQ(mode_v, test_mode::slow);
+    EXPECT_EQ(mode.try_assign("quick"), assign_status::ok);
+    EXPECT_EQ(mode_v, test_mode::fast);
+    EXPECT_EQ(mode.try_assign("slower"), assign_status::invalid_value);
+    EXPECT_EQ(mode.try_assign("0"), assign_status::invalid_value);
+
+    std::pmr::vector<std::pmr::string> values;
+    mode.allowed_values(values);
+    EXPECT_EQ(values.size(), 4u); // every name while nothing is matched
+
+    mode.match(test_mode::fast, test_mode::safe);
+    EXPECT_EQ(mode.value_info(), "(fast safe)");
+    EXPECT_EQ(mode.try_assign("safe"), assign_status::ok);
+    EXPECT_EQ(mode.try_assign("slow"), assign_status::not_allowed);
+
+    CLI::clipper cli("app");
+    std::vector<test_mode> modes_v;
+    cli.add_option<std::vector<test_mode>>("--modes").set("mode", modes_v).delimiter('+');
+    const char* argv[] = { "app", "--modes", "fast+slow", "--modes=quik", nullptr };
+    EXPECT_FALSE(cli.parse(4, const_cast<char**>(argv)));
+    EXPECT_EQ(modes_v, (std::vector<test_mode> { test_mode::fast, test_mode::slow }));
+    ASSERT_EQ(cli.wrong().size(), 1u);
+    EXPECT_NE(cli.wrong().front().find("(did you mean quick?)"), std::string::npos);
+}
@@ -83,4 +83,52 @@ TEST(PredicateTest, iless_than) {
   EXPECT_TRUE(CLI::iless_than<10.>(0.));
   EXPECT_TRUE(CLI::iless_than<1234>(123));
   EXPECT_TRUE(CLI::iless_than<3.f>(1.f));
-}
\ No newline at end of file
+}
+
+template<CLI::rules::rule R>
+static std::string describe(R r) {
+  std::string out;
+  r.describe(out);
+  return out;
+}
+
+TEST(PredicateTest, rules) {
+  using namespace CLI::rules;
+  constexpr auto r = ibetween<1, 64> && even;
+  static_assert(r.test(2) && r.test(64) && !r.test(3) && !r.test(66) && !r.test(0));
+  static_assert((between<0., 1.>).test(0.5) && !(between<0., 1.>).test(1.));
+  static_assert((greater_than<10>).test(11u) && !(greater_than<10>).test(10u));
+  static_assert((iless_than<-1>).test(-1) && !(iless_than<-1>).test(0u));
+  static_assert((less_than<5> || greater_than<10>).test(4) && !(less_than<5> || greater_than<10>).test(7));
+  static_assert(odd.test(3) && !odd.test(4) && (divisible_by<3>).test(9));
+
+  EXPECT_EQ(describe(r), "[1; 64] and even");
+  EXPECT_EQ(describe(between<0., 1.5>), "(0; 1.5)");
+  EXPECT_EQ(describe(igreater_than<-3>), ">= -3");
+  EXPECT_EQ(describe(less_than<5> || greater_than<10>), "< 5 or > 10");
+  EXPECT_EQ(describe((less_than<5> || greater_than<10>) && odd), "(< 5 or > 10) and odd");
+  EXPECT_EQ(describe(!(ibetween<1, 2> && even)), "not ([1; 2] and even)");
+  EXPECT_EQ(describe(!divisible_by<3>), "not divisible by 3");
+
+  constexpr auto lower = make("lower case", [](const std::string& s) { return !s.empty() && s.front() >= 'a' && s.front() <= 'z'; });
+  EXPECT_TRUE(lower.test(std::string("abc")));
+  EXPECT_FALSE((!lower).test(std::string("abc")));
+  EXPECT_EQ(describe(!lower), "not lower case");
+}
+
+template<typename O, typename R>
+concept can_validate = requires(O& opt, R r) { opt.validate(r); };
+
+TEST(PredicateTest, rule_constraints) {
+  using namespace CLI::rules;
+  static_assert(testable_for<decltype(ibetween<1, 9>), int>);
+  static_assert(!testable_for<decltype(ibetween<1, 9>), std::string>);
+  static_assert(!testable_for<decltype(even), double>);
+  static_assert(!testable_for<decltype(odd || less_than<0>), std::string>);
+
+  static_assert(can_validate<CLI::option<int>, decltype(ibetween<1, 9>)>);
+  static_assert(!can_validate<CLI::option<std::string>, decltype(ibetween<1, 9>)>);
+  static_assert(!can_validate<CLI::option<double>, decltype(divisible_by<3>)>);
+  static_assert(can_validate<CLI::option<std::vector<int>>, decltype(ibetween<1, 9> && odd)>);
+  static_assert(!can_validate<CLI::option<std::vector<std::string>>, decltype(ibetween<1, 9>)>);
+}